@@ -7,14 +7,10 @@
 #include "Container/BindingId.h"
 
 
-void DI::HandleBindingConflict(const FBindingId& BindingId, EBindConflictBehavior ConflictBehavior)
+namespace DI::Private
 {
-	if (ConflictBehavior != EBindConflictBehavior::None)
+	void ReportBindError(const FString& ErrorMessage, EBindConflictBehavior ConflictBehavior)
 	{
-		const FString ErrorMessage = FString::Printf(
-			TEXT("An instance for binding %s is already registered!"),
-			*BindingId.ToString()
-		);
 		switch (ConflictBehavior)
 		{
 		case EBindConflictBehavior::LogWarning:
@@ -33,7 +29,7 @@ void DI::HandleBindingConflict(const FBindingId& BindingId, EBindConflictBehavio
 				{
 					FBlueprintExceptionInfo ExceptionInfo(
 						EBlueprintExceptionType::FatalError,
-						INVTEXT("Binding conflict for binding %s")
+						FText::FromString(ErrorMessage)
 					);
 
 					FBlueprintCoreDelegates::ThrowScriptException(Frame->Object, *Frame, ExceptionInfo);
@@ -48,3 +44,41 @@ void DI::HandleBindingConflict(const FBindingId& BindingId, EBindConflictBehavio
 		}
 	}
 }
+
+void DI::HandleBindingConflict(const FBindingId& BindingId, EBindConflictBehavior ConflictBehavior)
+{
+	if (ConflictBehavior != EBindConflictBehavior::None)
+	{
+		Private::ReportBindError(
+			FString::Printf(TEXT("An instance for binding %s is already registered!"), *BindingId.ToString()),
+			ConflictBehavior
+		);
+	}
+}
+
+void DI::HandleBindingRejected(const FBindingId& BindingId, EBindRejectReason RejectReason, EBindConflictBehavior ConflictBehavior)
+{
+	if (ConflictBehavior != EBindConflictBehavior::None)
+	{
+		const TCHAR* Reason = TEXT("");
+		switch (RejectReason)
+		{
+		case EBindRejectReason::Sealed:
+			Reason = TEXT("the container has been sealed");
+			break;
+		case EBindRejectReason::NamedBindingInStaticContainer:
+			Reason = TEXT("static containers do not hold named bindings");
+			break;
+		case EBindRejectReason::TypeErasedBindingInStaticContainer:
+			Reason = TEXT("static containers can not store type erased bindings. Use Bind() instead");
+			break;
+		case EBindRejectReason::MultiBindingsUnsupported:
+			Reason = TEXT("the container does not support multi bindings");
+			break;
+		}
+		Private::ReportBindError(
+			FString::Printf(TEXT("Can not bind %s because %s."), *BindingId.ToString(), Reason),
+			ConflictBehavior
+		);
+	}
+}
@@ -0,0 +1,79 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingArena.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace DI
+{
+	FBindingArena::~FBindingArena()
+	{
+		// Every binding holds a reference to the arena, so all of them have been destroyed already.
+		check(NumBindings == 0);
+		for (uint8* Slab : Slabs)
+		{
+			FMemory::Free(Slab);
+		}
+	}
+
+	void* FBindingArena::Allocate(SIZE_T Size)
+	{
+		const uint32 SlotSize = static_cast<uint32>(sizeof(FSlotHeader) + Align(Size, SlotAlignment));
+
+		FScopeLock Lock(&CriticalSection);
+		FSlotHeader* Header = nullptr;
+		for (FFreeList& FreeList : FreeLists)
+		{
+			if (FreeList.SlotSize == SlotSize && FreeList.Head)
+			{
+				Header = FreeList.Head;
+				FreeList.Head = Header->NextFree;
+				break;
+			}
+		}
+
+		if (!Header)
+		{
+			if (!Cursor || Cursor + SlotSize > SlabEnd)
+			{
+				const SIZE_T SlabSize = FMath::Max<SIZE_T>(NextSlabSize, SlotSize);
+				uint8* Slab = static_cast<uint8*>(FMemory::Malloc(SlabSize, SlotAlignment));
+				Slabs.Add(Slab);
+				Cursor = Slab;
+				SlabEnd = Slab + SlabSize;
+				NextSlabSize = FMath::Min(NextSlabSize * 2, MaxSlabSize);
+			}
+			Header = reinterpret_cast<FSlotHeader*>(Cursor);
+			Cursor += SlotSize;
+		}
+
+		Header->Arena = this;
+		Header->SlotSize = SlotSize;
+		++NumBindings;
+		AddRef();
+		return Header + 1;
+	}
+
+	void FBindingArena::Free(void* Memory)
+	{
+		FSlotHeader* Header = static_cast<FSlotHeader*>(Memory) - 1;
+		FBindingArena* Arena = Header->Arena;
+		{
+			FScopeLock Lock(&Arena->CriticalSection);
+			FFreeList* FreeList = Arena->FreeLists.FindByPredicate([Header](const FFreeList& Candidate)
+			{
+				return Candidate.SlotSize == Header->SlotSize;
+			});
+			if (!FreeList)
+			{
+				FreeList = &Arena->FreeLists.Add_GetRef({Header->SlotSize, nullptr});
+			}
+			Header->NextFree = FreeList->Head;
+			FreeList->Head = Header;
+			--Arena->NumBindings;
+		}
+		// Might destroy the arena if its container is gone and this was the last binding.
+		Arena->Release();
+	}
+}
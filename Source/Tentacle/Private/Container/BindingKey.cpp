@@ -0,0 +1,129 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingKey.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "UObject/Class.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+namespace DI
+{
+	namespace Private
+	{
+		/**
+		 * Process wide registry that maps binding ids to dense indices and back.
+		 * Unnamed ids are numbered in their own range so the indices double as type slots.
+		 * UStructs are only referenced weakly, so ids of collected types are never dereferenced again.
+		 */
+		class FBindingKeyRegistry
+		{
+		public:
+			static FBindingKeyRegistry& Get()
+			{
+				static FBindingKeyRegistry Registry;
+				return Registry;
+			}
+
+			uint32 Intern(const FBindingId& BindingId)
+			{
+				{
+					FReadScopeLock ReadLock(Lock);
+					if (const uint32* ExistingIndex = IdToIndex.Find(BindingId))
+					{
+						if (FindEntry(*ExistingIndex)->IsTypeAlive())
+						{
+							return *ExistingIndex;
+						}
+					}
+				}
+
+				FWriteScopeLock WriteLock(Lock);
+				if (const uint32* ExistingIndex = IdToIndex.Find(BindingId))
+				{
+					// A stale entry means the UStruct has been collected and a new one lives at its address, which needs a key of its own.
+					if (FindEntry(*ExistingIndex)->IsTypeAlive())
+					{
+						return *ExistingIndex;
+					}
+				}
+				const uint32 NewIndex = BindingId.GetBindingName().IsNone()
+					                        ? static_cast<uint32>(UnnamedEntries.Emplace(BindingId))
+					                        : static_cast<uint32>(NamedEntries.Emplace(BindingId)) | FBindingKey::NamedFlag;
+				checkf(NewIndex != MAX_uint32, TEXT("Ran out of binding keys."));
+				IdToIndex.Add(BindingId, NewIndex);
+				return NewIndex;
+			}
+
+			FBindingId Resolve(uint32 Index)
+			{
+				FReadScopeLock ReadLock(Lock);
+				const FEntry* Entry = FindEntry(Index);
+				return Entry && Entry->IsTypeAlive() ? Entry->Id : FBindingId();
+			}
+
+			FString Describe(uint32 Index)
+			{
+				FReadScopeLock ReadLock(Lock);
+				const FEntry* Entry = FindEntry(Index);
+				return Entry
+					       ? FString::Printf(TEXT("%s:%s"), *Entry->TypeName.ToString(), *Entry->Id.GetBindingName().ToString())
+					       : FBindingId().ToString();
+			}
+
+		private:
+			struct FEntry
+			{
+				explicit FEntry(const FBindingId& InId)
+					: Id(InId), WeakType(InId.GetBoundTypeId().TryGetUType()), TypeName(InId.GetBoundTypeId().GetName())
+				{
+				}
+
+				/** @return false if the id refers to a UStruct that has been garbage collected. */
+				bool IsTypeAlive() const
+				{
+					return !WeakType.IsStale(/*bIncludingIfPendingKill*/ false);
+				}
+
+				FBindingId Id;
+				TWeakObjectPtr<UStruct> WeakType;
+				/** Captured while the type is alive so the key can still be described after it has been collected. */
+				FName TypeName;
+			};
+
+			FBindingKeyRegistry()
+			{
+				// Index 0 is reserved for the invalid key.
+				UnnamedEntries.Emplace(FBindingId());
+				IdToIndex.Add(FBindingId(), 0);
+			}
+
+			const FEntry* FindEntry(uint32 Index) const
+			{
+				const TArray<FEntry>& Entries = (Index & FBindingKey::NamedFlag) ? NamedEntries : UnnamedEntries;
+				const int32 ArrayIndex = static_cast<int32>(Index & ~FBindingKey::NamedFlag);
+				return Entries.IsValidIndex(ArrayIndex) ? &Entries[ArrayIndex] : nullptr;
+			}
+
+			FRWLock Lock;
+			TMap<FBindingId, uint32> IdToIndex;
+			TArray<FEntry> UnnamedEntries;
+			TArray<FEntry> NamedEntries;
+		};
+	}
+
+	FBindingKey::FBindingKey(const FBindingId& BindingId)
+		: Index(Private::FBindingKeyRegistry::Get().Intern(BindingId))
+	{
+	}
+
+	FBindingId FBindingKey::GetId() const
+	{
+		return Private::FBindingKeyRegistry::Get().Resolve(Index);
+	}
+
+	FString FBindingKey::ToString() const
+	{
+		return Private::FBindingKeyRegistry::Get().Describe(Index);
+	}
+}
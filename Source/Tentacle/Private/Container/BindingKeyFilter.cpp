@@ -0,0 +1,54 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingKeyFilter.h"
+
+namespace DI
+{
+	void FBindingKeyFilter::Reset(int32 NumExpectedKeys)
+	{
+		const uint32 NumBits = FMath::Max(
+			static_cast<uint32>(MinNumWords * 64),
+			FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(NumExpectedKeys, 1) * BitsPerKey)));
+		Words.Reset();
+		Words.SetNumZeroed(NumBits / 64);
+		Shift = 32 - FMath::FloorLog2(NumBits);
+		NumKeys = 0;
+	}
+
+	void FBindingKeyFilter::Union(const FBindingKeyFilter& Other)
+	{
+		NumKeys += Other.NumKeys;
+		if (Other.Words.Num() == Words.Num())
+		{
+			for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+			{
+				Words[WordIndex] |= Other.Words[WordIndex];
+			}
+			return;
+		}
+
+		// Both filters use the top bits of the same hashes, so a bit of the larger filter maps to the bit of the smaller one
+		// that shares its top bits.
+		const uint32 NumBits = GetNumBits();
+		const uint32 OtherNumBits = Other.GetNumBits();
+		for (int32 WordIndex = 0; WordIndex < Other.Words.Num(); ++WordIndex)
+		{
+			for (uint64 Word = Other.Words[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				const uint32 OtherBit = WordIndex * 64 + FMath::CountTrailingZeros64(Word);
+				if (OtherNumBits > NumBits)
+				{
+					SetBit(OtherBit / (OtherNumBits / NumBits));
+					continue;
+				}
+
+				const uint32 Ratio = NumBits / OtherNumBits;
+				for (uint32 Bit = OtherBit * Ratio; Bit < (OtherBit + 1) * Ratio; ++Bit)
+				{
+					SetBit(Bit);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,136 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingStorage.h"
+
+namespace DI
+{
+	EBindResult FBindingStorage::CanAdd(const FBindingKey& Key, EBindConflictBehavior ConflictBehavior) const
+	{
+		if (bSealed)
+		{
+			HandleBindingRejected(Key.GetId(), EBindRejectReason::Sealed, ConflictBehavior);
+			return EBindResult::Rejected;
+		}
+
+		if (const TSharedPtr<FBinding>* Binding = Find(Key))
+		{
+			if ((*Binding)->IsValid())
+			{
+				HandleBindingConflict(Key.GetId(), ConflictBehavior);
+				return EBindResult::Conflict;
+			}
+		}
+		return EBindResult::Bound;
+	}
+
+	void FBindingStorage::Add(TSharedRef<FBinding> Binding)
+	{
+		checkf(!bSealed, TEXT("Can not add binding %s to sealed binding storage."), *Binding->GetId().ToString());
+		const FBindingKey BindingKey = Binding->GetKey();
+		if (bUseTypeSlots && !BindingKey.IsNamed())
+		{
+			const int32 TypeSlot = static_cast<int32>(BindingKey.GetTypeSlot());
+			if (TypeSlot >= TypeSlots.Num())
+			{
+				TypeSlots.SetNum(TypeSlot + 1);
+			}
+			if (!TypeSlots[TypeSlot].IsValid())
+			{
+				++NumTypeSlotBindings;
+			}
+			TypeSlots[TypeSlot] = MoveTemp(Binding);
+			return;
+		}
+		Bindings.Emplace(BindingKey, MoveTemp(Binding));
+	}
+
+	void FBindingStorage::AddMulti(TSharedRef<FMultiBinding> MultiBinding)
+	{
+		checkf(!bSealed, TEXT("Can not add multi binding %s to sealed binding storage."), *MultiBinding->GetKey().ToString());
+		if (TSharedPtr<FMultiBinding>* ExistingMultiBinding = MultiBindings.Find(MultiBinding->GetKey()))
+		{
+			(*ExistingMultiBinding)->Append(*MultiBinding);
+			return;
+		}
+		MultiBindings.Emplace(MultiBinding->GetKey(), MoveTemp(MultiBinding));
+	}
+
+	void FBindingStorage::Seal()
+	{
+		if (bSealed)
+			return;
+
+		TArray<TSharedPtr<FBinding>> BindingsToSeal;
+		BindingsToSeal.Reserve(Bindings.Num());
+		for (auto It = Bindings.CreateConstIterator(); It; ++It)
+		{
+			BindingsToSeal.Add(It.Value());
+		}
+		SealedBindings = FSealedBindingTable(MoveTemp(BindingsToSeal));
+		Bindings.Empty();
+		TypeSlots.Shrink();
+		bSealed = true;
+	}
+
+	void FBindingStorage::EnableTypeSlots()
+	{
+		if (bUseTypeSlots)
+			return;
+
+		if (!ensureMsgf(!bSealed, TEXT("Type slots have to be enabled before sealing.")))
+			return;
+
+		bUseTypeSlots = true;
+
+		TArray<TSharedPtr<FBinding>> UnnamedBindings;
+		for (auto It = Bindings.CreateConstIterator(); It; ++It)
+		{
+			if (!It.Key().IsNamed())
+			{
+				UnnamedBindings.Add(It.Value());
+			}
+		}
+		for (TSharedPtr<FBinding>& UnnamedBinding : UnnamedBindings)
+		{
+			Bindings.Remove(UnnamedBinding->GetKey());
+			Add(UnnamedBinding.ToSharedRef());
+		}
+	}
+
+	int32 FBindingStorage::Num() const
+	{
+		return NumTypeSlotBindings + (bSealed ? SealedBindings.Num() : Bindings.Num());
+	}
+
+	void FBindingStorage::AddReferencedObjects(FReferenceCollector& Collector)
+	{
+		for (const TSharedPtr<FBinding>& Binding : TypeSlots)
+		{
+			if (Binding.IsValid())
+			{
+				Binding->AddReferencedObjects(Collector);
+			}
+		}
+
+		if (bSealed)
+		{
+			for (const TSharedPtr<FBinding>& Binding : SealedBindings.GetBindings())
+			{
+				Binding->AddReferencedObjects(Collector);
+			}
+		}
+		else
+		{
+			for (auto It = Bindings.CreateIterator(); It; ++It)
+			{
+				It.Value()->AddReferencedObjects(Collector);
+			}
+		}
+
+		for (auto It = MultiBindings.CreateIterator(); It; ++It)
+		{
+			It.Value()->AddReferencedObjects(Collector);
+		}
+	}
+}
@@ -8,27 +8,27 @@ namespace DI
 	void FBindingSubscriptionList::NotifyInstanceBound(const DI::FBinding& Binding)
 	{
 		FOnInstanceBound Subscriptions;
-		if (!BindingToSubscriptions.RemoveAndCopyValue(Binding.GetId(), Subscriptions))
+		if (!BindingToSubscriptions.RemoveAndCopyValue(Binding.GetKey(), Subscriptions))
 			return;
 
 		Subscriptions.Broadcast(Binding);
 	}
 
-	auto FBindingSubscriptionList::SubscribeOnce(const FBindingId& BindingId) -> FOnInstanceBound&
+	auto FBindingSubscriptionList::SubscribeOnce(const FBindingKey& BindingKey) -> FOnInstanceBound&
 	{
-		return BindingToSubscriptions.FindOrAdd(BindingId);
+		return BindingToSubscriptions.FindOrAdd(BindingKey);
 	}
 
-	TArray<FBindingId> FBindingSubscriptionList::GetAllPendingBindingIds() const
+	TArray<FBindingKey> FBindingSubscriptionList::GetAllPendingBindingKeys() const
 	{
-		TArray<FBindingId> OutIds;
-		BindingToSubscriptions.GetKeys(OutIds);
-		return OutIds;
+		TArray<FBindingKey> OutKeys;
+		BindingToSubscriptions.GetKeys(OutKeys);
+		return OutKeys;
 	}
 
-	bool FBindingSubscriptionList::Unsubscribe(const FBindingId& BindingId, FDelegateHandle DelegateHandle)
+	bool FBindingSubscriptionList::Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle)
 	{
-		FOnInstanceBound* Subscriptions = BindingToSubscriptions.Find(BindingId);
+		FOnInstanceBound* Subscriptions = BindingToSubscriptions.Find(BindingKey);
 		if (!Subscriptions)
 			return false;
 
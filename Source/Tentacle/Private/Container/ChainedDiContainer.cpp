@@ -3,6 +3,18 @@
 
 #include "Container/ChainedDiContainer.h"
 
+DI::FChainedDiContainer::~FChainedDiContainer()
+{
+	// Descendants might have cached bindings of this container.
+	for (const TWeakPtr<FConnectedDiContainer>& ChildContainer : ChildrenContainers)
+	{
+		if (TSharedPtr<FConnectedDiContainer> PinnedChildContainer = ChildContainer.Pin())
+		{
+			PinnedChildContainer->NotifyGraphChanged();
+		}
+	}
+}
+
 void DI::FChainedDiContainer::SetParentContainer(TSharedPtr<FConnectedDiContainer> DiContainer)
 {
 	if (ParentContainer == DiContainer)
@@ -17,6 +29,8 @@ void DI::FChainedDiContainer::SetParentContainer(TSharedPtr<FConnectedDiContaine
 	}
 
 	ParentContainer = DiContainer;
+	BorrowedParentContainer = DiContainer.Get();
+	NotifyGraphChanged();
 
 	if (DiContainer && !DiContainer->TryConnectSubcontainer(AsShared()))
 	{
@@ -26,10 +40,22 @@ void DI::FChainedDiContainer::SetParentContainer(TSharedPtr<FConnectedDiContaine
 
 void DI::FChainedDiContainer::AddReferencedObjects(FReferenceCollector& Collector)
 {
-	for (auto& [BindingId, Binding] : Bindings)
-	{
-		Binding->AddReferencedObjects(Collector);
-	}
+	Bindings.AddReferencedObjects(Collector);
+}
+
+void DI::FChainedDiContainer::Seal()
+{
+	Bindings.Seal();
+}
+
+bool DI::FChainedDiContainer::IsSealed() const
+{
+	return Bindings.IsSealed();
+}
+
+void DI::FChainedDiContainer::EnableTypeSlots()
+{
+	Bindings.EnableTypeSlots();
 }
 
 bool DI::FChainedDiContainer::TryConnectSubcontainer(TSharedRef<FConnectedDiContainer> ConnectedDiContainer)
@@ -46,6 +72,13 @@ bool DI::FChainedDiContainer::TryDisconnectSubcontainer(TSharedRef<FConnectedDiC
 
 void DI::FChainedDiContainer::NotifyInstanceBound(const DI::FBinding& NewBinding) const
 {
+	++BindGeneration;
+	BumpResolveGeneration();
+	BindingFilter.Add(NewBinding.GetKey());
+	if (BindingFilter.IsOverloaded())
+	{
+		RebuildBindingFilter();
+	}
 	Subscriptions.NotifyInstanceBound(NewBinding);
 	for (auto ChildrenContainerIt = ChildrenContainers.CreateIterator(); ChildrenContainerIt; ++ChildrenContainerIt)
 	{
@@ -60,12 +93,48 @@ void DI::FChainedDiContainer::NotifyInstanceBound(const DI::FBinding& NewBinding
 	}
 }
 
+void DI::FChainedDiContainer::NotifyGraphChanged() const
+{
+	++GraphGeneration;
+	BumpResolveGeneration();
+	for (auto ChildrenContainerIt = ChildrenContainers.CreateIterator(); ChildrenContainerIt; ++ChildrenContainerIt)
+	{
+		TSharedPtr<FConnectedDiContainer> ChildContainer = ChildrenContainerIt->Pin();
+		if (!ChildContainer.IsValid())
+		{
+			ChildrenContainerIt.RemoveCurrent();
+			continue;
+		}
+
+		ChildContainer->NotifyGraphChanged();
+	}
+}
+
+void DI::FChainedDiContainer::NotifyMultiInstancesBound() const
+{
+	BumpResolveGeneration();
+	for (auto ChildrenContainerIt = ChildrenContainers.CreateIterator(); ChildrenContainerIt; ++ChildrenContainerIt)
+	{
+		TSharedPtr<FConnectedDiContainer> ChildContainer = ChildrenContainerIt->Pin();
+		if (!ChildContainer.IsValid())
+		{
+			ChildrenContainerIt.RemoveCurrent();
+			continue;
+		}
+
+		ChildContainer->NotifyMultiInstancesBound();
+	}
+}
+
 void DI::FChainedDiContainer::RetryAllPendingWaits() const
 {
-	TArray<FBindingId> BindingIds = Subscriptions.GetAllPendingBindingIds();
-	for (const FBindingId& BindingId : BindingIds)
+	// Called when we got connected to a new ancestor, so its keys have to be known before looking for anything.
+	RebuildBindingFilter();
+
+	TArray<FBindingKey> BindingKeys = Subscriptions.GetAllPendingBindingKeys();
+	for (const FBindingKey& BindingKey : BindingKeys)
 	{
-		if (TSharedPtr<DI::FBinding> Binding = FindBinding(BindingId))
+		if (TSharedPtr<DI::FBinding> Binding = FindBinding(BindingKey))
 		{
 			Subscriptions.NotifyInstanceBound(*Binding);
 		}
@@ -84,31 +153,144 @@ void DI::FChainedDiContainer::RetryAllPendingWaits() const
 	}
 }
 
-TSharedPtr<DI::FBinding> DI::FChainedDiContainer::FindConnectedBinding(const DI::FBindingId& BindingId) const
+TSharedPtr<DI::FBinding> DI::FChainedDiContainer::FindConnectedBinding(const DI::FBindingKey& BindingKey) const
+{
+	if (HasMissedInCurrentLookup())
+	{
+		return {};
+	}
+	TSharedPtr<FBinding> Binding = FindBinding(BindingKey);
+	if (!Binding)
+	{
+		MarkMissedInCurrentLookup();
+	}
+	return Binding;
+}
+
+DI::FBinding* DI::FChainedDiContainer::FindConnectedBorrowedBinding(const DI::FBindingKey& BindingKey) const
+{
+	if (HasMissedInCurrentLookup())
+	{
+		return nullptr;
+	}
+	FBinding* Binding = FindBorrowedBinding(BindingKey);
+	if (!Binding)
+	{
+		MarkMissedInCurrentLookup();
+	}
+	return Binding;
+}
+
+void DI::FChainedDiContainer::FindConnectedBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const
+{
+	if (HasMissedInCurrentLookup())
+	{
+		return;
+	}
+	if (!FindBorrowedBindingsInChain(BindingKeys, OutBindings))
+	{
+		MarkMissedInCurrentLookup();
+	}
+}
+
+const DI::FMultiBinding* DI::FChainedDiContainer::FindConnectedMultiBinding(const DI::FBindingKey& BindingKey) const
+{
+	return FindMultiBinding(BindingKey);
+}
+
+const DI::FBindingKeyFilter& DI::FChainedDiContainer::GetBindingFilter() const
+{
+	return BindingFilter;
+}
+
+void DI::FChainedDiContainer::RebuildBindingFilter() const
 {
-	return FindBinding(BindingId);
+	const FBindingKeyFilter* ParentBindingFilter = BorrowedParentContainer && ParentContainer.IsValid()
+		                                               ? &BorrowedParentContainer->GetBindingFilter()
+		                                               : nullptr;
+	BindingFilter.Reset(Bindings.Num() + (ParentBindingFilter ? ParentBindingFilter->Num() : 0));
+	Bindings.ForEachKey([this](const FBindingKey& BindingKey)
+	{
+		BindingFilter.Add(BindingKey);
+	});
+	if (ParentBindingFilter)
+	{
+		BindingFilter.Union(*ParentBindingFilter);
+	}
 }
 
 DI::EBindResult DI::FChainedDiContainer::BindSpecific(TSharedRef<FBinding> SpecificBinding, EBindConflictBehavior ConflictBehavior)
 {
-	EBindResult OverallResult = EBindResult::Bound;
-	FBindingId BindingId = SpecificBinding->GetId();
-	if (TSharedRef<FBinding>* Binding = Bindings.Find(BindingId))
+	const EBindResult Result = Bindings.CanAdd(SpecificBinding->GetKey(), ConflictBehavior);
+	if (Result != EBindResult::Bound)
 	{
-		if ((*Binding)->IsValid())
+		return Result;
+	}
+
+	AddBinding(MoveTemp(SpecificBinding));
+	return EBindResult::Bound;
+}
+
+void DI::FChainedDiContainer::AddBinding(TSharedRef<FBinding> Binding)
+{
+	Bindings.Add(Binding);
+	NotifyInstanceBound(*Binding);
+}
+
+DI::EBindResult DI::FChainedDiContainer::CanBind(const FBindingKey& BindingKey, EBindConflictBehavior ConflictBehavior) const
+{
+	return Bindings.CanAdd(BindingKey, ConflictBehavior);
+}
+
+DI::EBindResult DI::FChainedDiContainer::BindMulti(TSharedRef<FMultiBinding> MultiBinding, EBindConflictBehavior ConflictBehavior)
+{
+	if (Bindings.IsSealed())
+	{
+		HandleBindingRejected(MultiBinding->GetKey().GetId(), EBindRejectReason::Sealed, ConflictBehavior);
+		return EBindResult::Rejected;
+	}
+
+	Bindings.AddMulti(MultiBinding);
+	NotifyMultiInstancesBound();
+	return EBindResult::Bound;
+}
+
+const DI::FMultiBinding* DI::FChainedDiContainer::FindMultiBinding(const FBindingKey& BindingKey) const
+{
+	const uint64 ResolveGeneration = GetResolveGeneration();
+	FMergedMultiBinding* MergedMultiBinding = MergedMultiBindings.Find(BindingKey);
+	if (MergedMultiBinding && MergedMultiBinding->ResolveGeneration == ResolveGeneration)
+	{
+		return MergedMultiBinding->Result;
+	}
+	if (!MergedMultiBinding)
+	{
+		MergedMultiBinding = &MergedMultiBindings.Emplace(BindingKey);
+	}
+
+	MergedMultiBinding->Begin(ResolveGeneration);
+	if (const FMultiBinding* LocalMultiBinding = Bindings.FindMulti(BindingKey))
+	{
+		MergedMultiBinding->Merge(*LocalMultiBinding, false);
+	}
+	if (BorrowedParentContainer && ParentContainer.IsValid())
+	{
+		if (const FMultiBinding* AncestorMultiBinding = BorrowedParentContainer->FindConnectedMultiBinding(BindingKey))
 		{
-			HandleBindingConflict(BindingId, ConflictBehavior);
-			return EBindResult::Conflict;
+			MergedMultiBinding->Merge(*AncestorMultiBinding, false);
 		}
 	}
-	Bindings.Emplace(BindingId, SpecificBinding);
-	NotifyInstanceBound(*SpecificBinding);
-	return OverallResult;
+	return MergedMultiBinding->Result;
 }
 
-TSharedPtr<DI::FBinding> DI::FChainedDiContainer::FindBinding(const FBindingId& BindingId) const
+TSharedPtr<DI::FBinding> DI::FChainedDiContainer::FindBinding(const FBindingKey& BindingKey) const
 {
-	if (const TSharedRef<FBinding>* DependencyBinding = Bindings.Find(BindingId))
+	if (!BindingFilter.MayContain(BindingKey))
+	{
+		return {};
+	}
+
+	if (const TSharedPtr<FBinding>* DependencyBinding = Bindings.Find(BindingKey))
 	{
 		if ((*DependencyBinding)->IsValid())
 		{
@@ -116,22 +298,131 @@ TSharedPtr<DI::FBinding> DI::FChainedDiContainer::FindBinding(const FBindingId&
 		}
 	}
 
-	if (TSharedPtr<FConnectedDiContainer> ParentDiContainer = ParentContainer.Pin())
+	if (const TSharedPtr<FBinding>* AncestorBinding = FindAncestorBinding(BindingKey))
 	{
-		return ParentDiContainer->FindConnectedBinding(BindingId);
+		return *AncestorBinding;
 	}
 	return {};
 }
 
+DI::FBinding* DI::FChainedDiContainer::FindBorrowedBinding(const FBindingKey& BindingKey) const
+{
+	if (!BindingFilter.MayContain(BindingKey))
+	{
+		return nullptr;
+	}
+
+	if (const TSharedPtr<FBinding>* DependencyBinding = Bindings.Find(BindingKey))
+	{
+		if ((*DependencyBinding)->IsValid())
+		{
+			return DependencyBinding->Get();
+		}
+	}
+
+	if (const TSharedPtr<FBinding>* AncestorBinding = FindAncestorBinding(BindingKey))
+	{
+		return AncestorBinding->Get();
+	}
+	return nullptr;
+}
+
+void DI::FChainedDiContainer::FindBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const
+{
+	FLookupScope LookupScope;
+	FindBorrowedBindingsInChain(BindingKeys, OutBindings);
+}
+
+bool DI::FChainedDiContainer::FindBorrowedBindingsInChain(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const
+{
+	check(BindingKeys.Num() == OutBindings.Num());
+	for (int32 Index = 0; Index < BindingKeys.Num(); ++Index)
+	{
+		if (!OutBindings[Index])
+		{
+			Bindings.Prefetch(BindingKeys[Index]);
+		}
+	}
+
+	RefreshAncestorCache();
+	bool bNeedsAncestors = false;
+	for (int32 Index = 0; Index < BindingKeys.Num(); ++Index)
+	{
+		const FBindingKey& BindingKey = BindingKeys[Index];
+		if (OutBindings[Index] || !BindingFilter.MayContain(BindingKey))
+			continue;
+
+		if (const TSharedPtr<FBinding>* DependencyBinding = Bindings.Find(BindingKey))
+		{
+			if ((*DependencyBinding)->IsValid())
+			{
+				OutBindings[Index] = DependencyBinding->Get();
+				continue;
+			}
+		}
+		if (const TSharedPtr<FBinding>* CachedBinding = AncestorCache.Find(BindingKey))
+		{
+			if ((*CachedBinding)->IsValid())
+			{
+				OutBindings[Index] = CachedBinding->Get();
+				continue;
+			}
+		}
+		bNeedsAncestors = true;
+	}
+
+	// The parent skips all keys that have been found already, so the whole batch can be passed on.
+	if (bNeedsAncestors && BorrowedParentContainer && ParentContainer.IsValid())
+	{
+		BorrowedParentContainer->FindConnectedBorrowedBindings(BindingKeys, OutBindings);
+	}
+	return !OutBindings.Contains(nullptr);
+}
+
+void DI::FChainedDiContainer::RefreshAncestorCache() const
+{
+	if (AncestorCacheGraphGeneration != GraphGeneration || AncestorCacheBindGeneration != BindGeneration)
+	{
+		AncestorCache.Reset();
+		AncestorCacheGraphGeneration = GraphGeneration;
+		AncestorCacheBindGeneration = BindGeneration;
+	}
+}
+
+const TSharedPtr<DI::FBinding>* DI::FChainedDiContainer::FindAncestorBinding(const FBindingKey& BindingKey) const
+{
+	RefreshAncestorCache();
+	if (const TSharedPtr<FBinding>* CachedBinding = AncestorCache.Find(BindingKey))
+	{
+		// Objects can be destroyed without a bind notification, so the binding has to be checked again.
+		if ((*CachedBinding)->IsValid())
+		{
+			return CachedBinding;
+		}
+	}
+
+	// IsValid only reads the reference count while Pin would have to increment and decrement it.
+	if (!BorrowedParentContainer || !ParentContainer.IsValid())
+	{
+		return nullptr;
+	}
+	TSharedPtr<FBinding> AncestorBinding = BorrowedParentContainer->FindConnectedBinding(BindingKey);
+	if (!AncestorBinding)
+	{
+		return nullptr;
+	}
+	return &AncestorCache.Emplace(BindingKey, MoveTemp(AncestorBinding));
+}
+
 DI::FBindingSubscriptionList::FOnInstanceBound& DI::FChainedDiContainer::Subscribe(
-	const FBindingId& BindingId) const
+	const FBindingKey& BindingKey) const
 {
-	return Subscriptions.SubscribeOnce(BindingId);
+	return Subscriptions.SubscribeOnce(BindingKey);
 }
 
-bool DI::FChainedDiContainer::Unsubscribe(const FBindingId& BindingId, FDelegateHandle DelegateHandle) const
+bool DI::FChainedDiContainer::Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle) const
 {
-	return Subscriptions.Unsubscribe(BindingId, DelegateHandle);
+	return Subscriptions.Unsubscribe(BindingKey, DelegateHandle);
 }
 
 void FChainedDiContainerGCd::AddStructReferencedObjects(FReferenceCollector& Collector)
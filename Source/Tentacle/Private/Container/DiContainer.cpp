@@ -5,34 +5,83 @@
 
 namespace DI
 {
-	bool FDiContainer::Unsubscribe(const FBindingId& BindingId, FDelegateHandle DelegateHandle) const
+	bool FDiContainer::Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle) const
 	{
-		return Subscriptions.Unsubscribe(BindingId, DelegateHandle);
+		return Subscriptions.Unsubscribe(BindingKey, DelegateHandle);
 	}
 
 	void FDiContainer::AddReferencedObjects(FReferenceCollector& Collector)
 	{
-		for (auto& [BindingId, Binding] : Bindings)
+		Bindings.AddReferencedObjects(Collector);
+	}
+
+	void FDiContainer::Seal()
+	{
+		Bindings.Seal();
+	}
+
+	bool FDiContainer::IsSealed() const
+	{
+		return Bindings.IsSealed();
+	}
+
+	void FDiContainer::EnableTypeSlots()
+	{
+		Bindings.EnableTypeSlots();
+	}
+
+	TSharedPtr<DI::FBinding> FDiContainer::FindBinding(const FBindingKey& BindingKey) const
+	{
+		if (const TSharedPtr<DI::FBinding>* DependencyBinding = Bindings.Find(BindingKey))
 		{
-			Binding->AddReferencedObjects(Collector);
+			if ((*DependencyBinding)->IsValid())
+			{
+				return *DependencyBinding;
+			}
 		}
+		return nullptr;
 	}
 
-	TSharedPtr<DI::FBinding> FDiContainer::FindBinding(const FBindingId& BindingId) const
+	DI::FBinding* FDiContainer::FindBorrowedBinding(const FBindingKey& BindingKey) const
 	{
-		if (const TSharedRef<DI::FBinding>* DependencyBinding = Bindings.Find(BindingId))
+		if (const TSharedPtr<DI::FBinding>* DependencyBinding = Bindings.Find(BindingKey))
 		{
 			if ((*DependencyBinding)->IsValid())
 			{
-				return *DependencyBinding;
+				return DependencyBinding->Get();
 			}
 		}
 		return nullptr;
 	}
 
-	FBindingSubscriptionList::FOnInstanceBound& FDiContainer::Subscribe(const FBindingId& BindingId) const
+	void FDiContainer::FindBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const
+	{
+		check(BindingKeys.Num() == OutBindings.Num());
+		for (int32 Index = 0; Index < BindingKeys.Num(); ++Index)
+		{
+			if (!OutBindings[Index])
+			{
+				Bindings.Prefetch(BindingKeys[Index]);
+			}
+		}
+		for (int32 Index = 0; Index < BindingKeys.Num(); ++Index)
+		{
+			if (OutBindings[Index])
+				continue;
+
+			if (const TSharedPtr<DI::FBinding>* DependencyBinding = Bindings.Find(BindingKeys[Index]))
+			{
+				if ((*DependencyBinding)->IsValid())
+				{
+					OutBindings[Index] = DependencyBinding->Get();
+				}
+			}
+		}
+	}
+
+	FBindingSubscriptionList::FOnInstanceBound& FDiContainer::Subscribe(const FBindingKey& BindingKey) const
 	{
-		return Subscriptions.SubscribeOnce(BindingId);
+		return Subscriptions.SubscribeOnce(BindingKey);
 	}
 
 	TBindingHelper<FDiContainer> FDiContainer::Bind()
@@ -54,17 +103,38 @@ namespace DI
 		TSharedRef<DI::FBinding> SpecificBinding,
 		EBindConflictBehavior ConflictBehavior)
 	{
-		FBindingId BindingId = SpecificBinding->GetId();
-		if (TSharedRef<FBinding>* Binding = Bindings.Find(BindingId))
+		const EBindResult Result = Bindings.CanAdd(SpecificBinding->GetKey(), ConflictBehavior);
+		if (Result != EBindResult::Bound)
 		{
-			if ((*Binding)->IsValid())
-			{
-				HandleBindingConflict(BindingId, ConflictBehavior);
-				return EBindResult::Conflict;
-			}
+			return Result;
 		}
-		Bindings.Emplace(BindingId, SpecificBinding);
-		Subscriptions.NotifyInstanceBound(*SpecificBinding);
+
+		AddBinding(MoveTemp(SpecificBinding));
 		return EBindResult::Bound;
 	}
+
+	void FDiContainer::AddBinding(TSharedRef<DI::FBinding> Binding)
+	{
+		Bindings.Add(Binding);
+		BumpResolveGeneration();
+		Subscriptions.NotifyInstanceBound(*Binding);
+	}
+
+	EBindResult FDiContainer::BindMulti(TSharedRef<FMultiBinding> MultiBinding, EBindConflictBehavior ConflictBehavior)
+	{
+		if (Bindings.IsSealed())
+		{
+			HandleBindingRejected(MultiBinding->GetKey().GetId(), EBindRejectReason::Sealed, ConflictBehavior);
+			return EBindResult::Rejected;
+		}
+
+		Bindings.AddMulti(MultiBinding);
+		BumpResolveGeneration();
+		return EBindResult::Bound;
+	}
+
+	const FMultiBinding* FDiContainer::FindMultiBinding(const FBindingKey& BindingKey) const
+	{
+		return Bindings.FindMulti(BindingKey);
+	}
 }
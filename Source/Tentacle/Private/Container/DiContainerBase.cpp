@@ -0,0 +1,47 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/DiContainerBase.h"
+
+void DI::FDiContainerBase::FindBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const
+{
+	check(BindingKeys.Num() == OutBindings.Num());
+	for (int32 Index = 0; Index < BindingKeys.Num(); ++Index)
+	{
+		if (!OutBindings[Index])
+		{
+			OutBindings[Index] = FindBorrowedBinding(BindingKeys[Index]);
+		}
+	}
+}
+
+namespace DI::Private
+{
+	// Lookups happen on the thread that resolves, so the current lookup is tracked per thread.
+	thread_local uint64 GCurrentLookupId = 0;
+	std::atomic<uint64> GNextLookupId = 1;
+}
+
+DI::FConnectedDiContainer::FLookupScope::FLookupScope()
+	: PreviousLookupId(Private::GCurrentLookupId)
+{
+	if (PreviousLookupId == 0)
+	{
+		Private::GCurrentLookupId = Private::GNextLookupId.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+DI::FConnectedDiContainer::FLookupScope::~FLookupScope()
+{
+	Private::GCurrentLookupId = PreviousLookupId;
+}
+
+bool DI::FConnectedDiContainer::HasMissedInCurrentLookup() const
+{
+	return Private::GCurrentLookupId != 0 && LastMissedLookupId == Private::GCurrentLookupId;
+}
+
+void DI::FConnectedDiContainer::MarkMissedInCurrentLookup() const
+{
+	LastMissedLookupId = Private::GCurrentLookupId;
+}
@@ -3,20 +3,33 @@
 
 #include "Container/ForkingDiContainer.h"
 
+DI::FForkingDiContainer::~FForkingDiContainer()
+{
+	// Descendants might have cached bindings that were found through this container.
+	for (const TWeakPtr<FConnectedDiContainer>& ChildContainer : ChildrenContainers)
+	{
+		if (TSharedPtr<FConnectedDiContainer> PinnedChildContainer = ChildContainer.Pin())
+		{
+			PinnedChildContainer->NotifyGraphChanged();
+		}
+	}
+}
+
 void DI::FForkingDiContainer::AddParentContainer(TSharedRef<FConnectedDiContainer> DiContainer, int32 Priority)
 {
 	// Remove all existing instances disregarding priority.
 	// This will cause the priority to be "overwritten" if you add the same DiContainer with a different priority.
 	ParentContainers.RemoveAll([DiContainer](const auto& PrioritizedParent)
 	{
-		return PrioritizedParent.Value == DiContainer;
+		return PrioritizedParent.Container == DiContainer;
 	});
 
-	ParentContainers.Add({Priority, MoveTemp(DiContainer)});
+	ParentContainers.Add({Priority, DiContainer, &DiContainer.Get()});
 	ParentContainers.StableSort([](const auto& Lhs, const auto& Rhs)
 	{
-		return Lhs.Key >= Rhs.Key;
+		return Lhs.Priority >= Rhs.Priority;
 	});
+	NotifyGraphChanged();
 	
 	if (!DiContainer->TryConnectSubcontainer(AsShared()))
 	{
@@ -28,10 +41,11 @@ void DI::FForkingDiContainer::RemoveParentContainer(TWeakPtr<FConnectedDiContain
 {
 	for (auto It = ParentContainers.CreateIterator(); It; ++It)
 	{
-		if (It->Value != DiContainer)
+		if (It->Container != DiContainer)
 			continue;
 
 		It.RemoveCurrent();
+		NotifyGraphChanged();
 
 		TSharedPtr<FConnectedDiContainer> PinnedParent = DiContainer.Pin();
 		if (!PinnedParent)
@@ -58,6 +72,13 @@ bool DI::FForkingDiContainer::TryDisconnectSubcontainer(TSharedRef<FConnectedDiC
 
 void DI::FForkingDiContainer::NotifyInstanceBound(const DI::FBinding& NewBinding) const
 {
+	++BindGeneration;
+	++ResolveGeneration;
+	BindingFilter.Add(NewBinding.GetKey());
+	if (BindingFilter.IsOverloaded())
+	{
+		RebuildBindingFilter();
+	}
 	for (auto ChildrenContainerIt = ChildrenContainers.CreateIterator(); ChildrenContainerIt; ++ChildrenContainerIt)
 	{
 		TSharedPtr<FConnectedDiContainer> ChainedDiContainer = ChildrenContainerIt->Pin();
@@ -71,8 +92,43 @@ void DI::FForkingDiContainer::NotifyInstanceBound(const DI::FBinding& NewBinding
 	}
 }
 
+void DI::FForkingDiContainer::NotifyGraphChanged() const
+{
+	++GraphGeneration;
+	++ResolveGeneration;
+	for (auto ChildrenContainerIt = ChildrenContainers.CreateIterator(); ChildrenContainerIt; ++ChildrenContainerIt)
+	{
+		TSharedPtr<FConnectedDiContainer> ChainedDiContainer = ChildrenContainerIt->Pin();
+		if (!ChainedDiContainer.IsValid())
+		{
+			ChildrenContainerIt.RemoveCurrent();
+			continue;
+		}
+
+		ChainedDiContainer->NotifyGraphChanged();
+	}
+}
+
+void DI::FForkingDiContainer::NotifyMultiInstancesBound() const
+{
+	++ResolveGeneration;
+	for (auto ChildrenContainerIt = ChildrenContainers.CreateIterator(); ChildrenContainerIt; ++ChildrenContainerIt)
+	{
+		TSharedPtr<FConnectedDiContainer> ChainedDiContainer = ChildrenContainerIt->Pin();
+		if (!ChainedDiContainer.IsValid())
+		{
+			ChildrenContainerIt.RemoveCurrent();
+			continue;
+		}
+
+		ChainedDiContainer->NotifyMultiInstancesBound();
+	}
+}
+
 void DI::FForkingDiContainer::RetryAllPendingWaits() const
 {
+	RebuildBindingFilter();
+
 	for (auto ChildrenContainerIt = ChildrenContainers.CreateIterator(); ChildrenContainerIt; ++ChildrenContainerIt)
 	{
 		TSharedPtr<FConnectedDiContainer> ChainedDiContainer = ChildrenContainerIt->Pin();
@@ -86,21 +142,180 @@ void DI::FForkingDiContainer::RetryAllPendingWaits() const
 	}
 }
 
-TSharedPtr<DI::FBinding> DI::FForkingDiContainer::FindConnectedBinding(const FBindingId& BindingId) const
+TSharedPtr<DI::FBinding> DI::FForkingDiContainer::FindConnectedBinding(const FBindingKey& BindingKey) const
 {
+	if (const TSharedPtr<FBinding>* Binding = FindWinningBinding(BindingKey))
+	{
+		return *Binding;
+	}
+	return {};
+}
+
+DI::FBinding* DI::FForkingDiContainer::FindConnectedBorrowedBinding(const FBindingKey& BindingKey) const
+{
+	if (const TSharedPtr<FBinding>* Binding = FindWinningBinding(BindingKey))
+	{
+		return Binding->Get();
+	}
+	return nullptr;
+}
+
+const TSharedPtr<DI::FBinding>* DI::FForkingDiContainer::FindWinningBinding(const FBindingKey& BindingKey) const
+{
+	if (!BindingFilter.MayContain(BindingKey))
+	{
+		return nullptr;
+	}
+
+	RefreshWinnerCache();
+	if (const TSharedPtr<FBinding>* CachedBinding = WinnerCache.Find(BindingKey))
+	{
+		// Objects can be destroyed without a bind notification, so the binding has to be checked again.
+		if ((*CachedBinding)->IsValid())
+		{
+			return CachedBinding;
+		}
+	}
+
+	// Shared ancestors only get searched once, no matter how many of our parents lead to them.
+	FLookupScope LookupScope;
+	if (HasMissedInCurrentLookup())
+	{
+		return nullptr;
+	}
+
 	for (auto It = ParentContainers.CreateIterator(); It; ++It)
 	{
-		TSharedPtr<FConnectedDiContainer> ParentDiContainer = It->Value.Pin();
-		if (!ParentDiContainer.IsValid())
+		// IsValid only reads the reference count while Pin would have to increment and decrement it.
+		if (!It->Container.IsValid())
 		{
 			It.RemoveCurrent();
 			continue;
 		}
 
-		if (TSharedPtr<DI::FBinding> Binding = ParentDiContainer->FindConnectedBinding(BindingId))
+		if (TSharedPtr<DI::FBinding> Binding = It->BorrowedContainer->FindConnectedBinding(BindingKey))
 		{
-			return Binding;
+			return &WinnerCache.Emplace(BindingKey, MoveTemp(Binding));
+		}
+	}
+	MarkMissedInCurrentLookup();
+	return nullptr;
+}
+
+void DI::FForkingDiContainer::RefreshWinnerCache() const
+{
+	if (WinnerCacheGraphGeneration != GraphGeneration || WinnerCacheBindGeneration != BindGeneration)
+	{
+		WinnerCache.Reset();
+		WinnerCacheGraphGeneration = GraphGeneration;
+		WinnerCacheBindGeneration = BindGeneration;
+	}
+}
+
+void DI::FForkingDiContainer::FindConnectedBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const
+{
+	check(BindingKeys.Num() == OutBindings.Num());
+	FLookupScope LookupScope;
+	if (HasMissedInCurrentLookup())
+	{
+		return;
+	}
+
+	RefreshWinnerCache();
+	bool bNeedsParents = false;
+	for (int32 Index = 0; Index < BindingKeys.Num(); ++Index)
+	{
+		const FBindingKey& BindingKey = BindingKeys[Index];
+		if (OutBindings[Index] || !BindingFilter.MayContain(BindingKey))
+			continue;
+
+		if (const TSharedPtr<FBinding>* CachedBinding = WinnerCache.Find(BindingKey))
+		{
+			if ((*CachedBinding)->IsValid())
+			{
+				OutBindings[Index] = CachedBinding->Get();
+				continue;
+			}
+		}
+		bNeedsParents = true;
+	}
+
+	if (bNeedsParents)
+	{
+		// Parents skip the keys that higher priority parents have already found, which keeps the priority order intact.
+		for (auto It = ParentContainers.CreateIterator(); It; ++It)
+		{
+			if (!It->Container.IsValid())
+			{
+				It.RemoveCurrent();
+				continue;
+			}
+
+			It->BorrowedContainer->FindConnectedBorrowedBindings(BindingKeys, OutBindings);
+			if (!OutBindings.Contains(nullptr))
+			{
+				return;
+			}
+		}
+	}
+
+	if (OutBindings.Contains(nullptr))
+	{
+		MarkMissedInCurrentLookup();
+	}
+}
+
+const DI::FMultiBinding* DI::FForkingDiContainer::FindConnectedMultiBinding(const DI::FBindingKey& BindingKey) const
+{
+	FMergedMultiBinding* MergedMultiBinding = MergedMultiBindings.Find(BindingKey);
+	if (MergedMultiBinding && MergedMultiBinding->ResolveGeneration == ResolveGeneration)
+	{
+		return MergedMultiBinding->Result;
+	}
+	if (!MergedMultiBinding)
+	{
+		MergedMultiBinding = &MergedMultiBindings.Emplace(BindingKey);
+	}
+
+	MergedMultiBinding->Begin(ResolveGeneration);
+	for (auto It = ParentContainers.CreateIterator(); It; ++It)
+	{
+		if (!It->Container.IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (const FMultiBinding* ParentMultiBinding = It->BorrowedContainer->FindConnectedMultiBinding(BindingKey))
+		{
+			MergedMultiBinding->Merge(*ParentMultiBinding, true);
+		}
+	}
+	return MergedMultiBinding->Result;
+}
+
+const DI::FBindingKeyFilter& DI::FForkingDiContainer::GetBindingFilter() const
+{
+	return BindingFilter;
+}
+
+void DI::FForkingDiContainer::RebuildBindingFilter() const
+{
+	int32 NumExpectedKeys = 0;
+	for (const FParentContainer& Parent : ParentContainers)
+	{
+		if (Parent.Container.IsValid())
+		{
+			NumExpectedKeys += Parent.BorrowedContainer->GetBindingFilter().Num();
+		}
+	}
+
+	BindingFilter.Reset(NumExpectedKeys);
+	for (const FParentContainer& Parent : ParentContainers)
+	{
+		if (Parent.Container.IsValid())
+		{
+			BindingFilter.Union(Parent.BorrowedContainer->GetBindingFilter());
 		}
 	}
-	return {};
 }
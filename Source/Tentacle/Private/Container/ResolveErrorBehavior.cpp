@@ -5,44 +5,62 @@
 #include "Tentacle.h"
 #include "Blueprint/BlueprintExceptionInfo.h"
 #include "Container/BindingId.h"
+#include "Container/BindingKey.h"
 
-void DI::HandleResolveError(const FBindingId& BindingId, EResolveErrorBehavior ErrorBehavior)
+namespace DI::Private
 {
-	if (ErrorBehavior == EResolveErrorBehavior::ReturnNull)
-		return;
-
-	FString ErrorMessage = FString::Printf(TEXT("Failed to resolve binding %s"), *BindingId.ToString());
-	switch (ErrorBehavior)
+	void ReportResolveError(const FString& BindingDescription, EResolveErrorBehavior ErrorBehavior)
 	{
-	case EResolveErrorBehavior::ReturnNull:
-		break;
-	case EResolveErrorBehavior::LogWarning:
-		UE_LOG(LogDependencyInjection, Warning, TEXT("%s"), *ErrorMessage)
-		break;
-	case EResolveErrorBehavior::LogError:
-		UE_LOG(LogDependencyInjection, Error, TEXT("%s"), *ErrorMessage)
-		break;
-	case EResolveErrorBehavior::EnsureAlways:
-		ensureAlwaysMsgf(false, TEXT("%s"), *ErrorMessage);
-		break;
-	case EResolveErrorBehavior::BlueprintException:
+		FString ErrorMessage = FString::Printf(TEXT("Failed to resolve binding %s"), *BindingDescription);
+		switch (ErrorBehavior)
 		{
-			FFrame* Frame = FFrame::GetThreadLocalTopStackFrame();
-			ensureMsgf(Frame, TEXT("Error behavior is BlueprintException but we do not seem to be inside a blueprint context!"));
-			if (Frame)
+		case EResolveErrorBehavior::ReturnNull:
+			break;
+		case EResolveErrorBehavior::LogWarning:
+			UE_LOG(LogDependencyInjection, Warning, TEXT("%s"), *ErrorMessage)
+			break;
+		case EResolveErrorBehavior::LogError:
+			UE_LOG(LogDependencyInjection, Error, TEXT("%s"), *ErrorMessage)
+			break;
+		case EResolveErrorBehavior::EnsureAlways:
+			ensureAlwaysMsgf(false, TEXT("%s"), *ErrorMessage);
+			break;
+		case EResolveErrorBehavior::BlueprintException:
 			{
-				FBlueprintExceptionInfo ExceptionInfo(
-					EBlueprintExceptionType::AbortExecution,
-					FText::FromString(ErrorMessage)
-				);
-
-				FBlueprintCoreDelegates::ThrowScriptException(Frame->Object, *Frame, ExceptionInfo);
-				// Put break in here so that if the frame is invalid we fall through to the AssertCheck version.
-				break;
+				FFrame* Frame = FFrame::GetThreadLocalTopStackFrame();
+				ensureMsgf(Frame, TEXT("Error behavior is BlueprintException but we do not seem to be inside a blueprint context!"));
+				if (Frame)
+				{
+					FBlueprintExceptionInfo ExceptionInfo(
+						EBlueprintExceptionType::AbortExecution,
+						FText::FromString(ErrorMessage)
+					);
+
+					FBlueprintCoreDelegates::ThrowScriptException(Frame->Object, *Frame, ExceptionInfo);
+					// Put break in here so that if the frame is invalid we fall through to the AssertCheck version.
+					break;
+				}
 			}
+		case EResolveErrorBehavior::AssertCheck:
+			checkf(false, TEXT("%s"), *ErrorMessage);
+			break;
 		}
-	case EResolveErrorBehavior::AssertCheck:
-		checkf(false, TEXT("%s"), *ErrorMessage);
-		break;
 	}
 }
+
+void DI::HandleResolveError(const FBindingId& BindingId, EResolveErrorBehavior ErrorBehavior)
+{
+	if (ErrorBehavior == EResolveErrorBehavior::ReturnNull)
+		return;
+
+	Private::ReportResolveError(BindingId.ToString(), ErrorBehavior);
+}
+
+void DI::HandleResolveError(const FBindingKey& BindingKey, EResolveErrorBehavior ErrorBehavior)
+{
+	if (ErrorBehavior == EResolveErrorBehavior::ReturnNull)
+		return;
+
+	// Subscribed keys may outlive their UStruct, so describe the key instead of dereferencing its id.
+	Private::ReportResolveError(BindingKey.ToString(), ErrorBehavior);
+}
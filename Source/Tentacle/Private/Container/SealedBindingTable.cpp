@@ -0,0 +1,125 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/SealedBindingTable.h"
+
+namespace DI
+{
+	namespace Private
+	{
+		/** Average number of keys per bucket. Bigger buckets need fewer displacements but take longer to place. */
+		constexpr uint32 GSealedBindingTableBucketSize = 4;
+
+		/** Displacements tried for a bucket before starting over with another seed. */
+		constexpr uint32 GSealedBindingTableMaxDisplacement = 1 << 16;
+
+		/** Seeds tried before giving up. Every seed after the first one also adds a few slots. */
+		constexpr uint32 GSealedBindingTableMaxSeeds = 16;
+	}
+
+	FSealedBindingTable::FSealedBindingTable()
+	{
+		// Always keep at least one slot and bucket so Find never has to check for an empty table.
+		Slots.AddDefaulted(1);
+		Displacements.AddZeroed(1);
+	}
+
+	FSealedBindingTable::FSealedBindingTable(TArray<TSharedPtr<FBinding>> InBindings)
+		: Bindings(MoveTemp(InBindings))
+	{
+		const uint32 NumBindings = static_cast<uint32>(Bindings.Num());
+		Displacements.AddZeroed(FMath::Max(1u, FMath::DivideAndRoundUp(NumBindings, Private::GSealedBindingTableBucketSize)));
+
+		// A quarter of the slots stays free so the last buckets, which are placed into an almost full table, still find room quickly.
+		uint32 NumSlots = FMath::Max(1u, NumBindings + NumBindings / 4);
+		for (uint32 Attempt = 0; Attempt < Private::GSealedBindingTableMaxSeeds; ++Attempt)
+		{
+			if (TryBuildSlots(Attempt, NumSlots))
+			{
+				return;
+			}
+			NumSlots += NumSlots / 16 + 1;
+		}
+		checkf(false, TEXT("Failed to build a perfect hash for %d bindings."), Bindings.Num());
+	}
+
+	bool FSealedBindingTable::TryBuildSlots(uint32 InSeed, uint32 NumSlots)
+	{
+		Seed = InSeed;
+		Slots.Reset();
+		Slots.AddDefaulted(NumSlots);
+
+		TArray<uint64> KeyHashes;
+		KeyHashes.SetNumUninitialized(Bindings.Num());
+		TArray<TArray<int32, TInlineAllocator<Private::GSealedBindingTableBucketSize * 2>>> Buckets;
+		Buckets.SetNum(Displacements.Num());
+		for (int32 BindingIndex = 0; BindingIndex < Bindings.Num(); ++BindingIndex)
+		{
+			KeyHashes[BindingIndex] = HashKey(Bindings[BindingIndex]->GetKey().GetIndex(), Seed);
+			Buckets[GetBucketIndex(KeyHashes[BindingIndex])].Add(BindingIndex);
+		}
+
+		// Big buckets are the hardest to place, so they go first while the table is still empty.
+		TArray<int32> BucketOrder;
+		BucketOrder.Reserve(Buckets.Num());
+		for (int32 BucketIndex = 0; BucketIndex < Buckets.Num(); ++BucketIndex)
+		{
+			if (Buckets[BucketIndex].Num() > 0)
+			{
+				BucketOrder.Add(BucketIndex);
+			}
+		}
+		BucketOrder.StableSort([&Buckets](int32 Lhs, int32 Rhs)
+		{
+			return Buckets[Lhs].Num() > Buckets[Rhs].Num();
+		});
+
+		TBitArray<> UsedSlots(false, static_cast<int32>(NumSlots));
+		TArray<uint32, TInlineAllocator<Private::GSealedBindingTableBucketSize * 2>> BucketSlots;
+		for (const int32 BucketIndex : BucketOrder)
+		{
+			const auto& Bucket = Buckets[BucketIndex];
+			for (int32 Index = 0; Index < Bucket.Num(); ++Index)
+			{
+				for (int32 OtherIndex = Index + 1; OtherIndex < Bucket.Num(); ++OtherIndex)
+				{
+					// The key hash is a bijection, so equal hashes mean equal keys.
+					checkf(KeyHashes[Bucket[Index]] != KeyHashes[Bucket[OtherIndex]],
+					       TEXT("Duplicate binding %s in sealed binding table."), *Bindings[Bucket[Index]]->GetId().ToString());
+				}
+			}
+
+			bool bPlaced = false;
+			uint32 Displacement = 0;
+			for (; Displacement < Private::GSealedBindingTableMaxDisplacement; ++Displacement)
+			{
+				BucketSlots.Reset();
+				bPlaced = true;
+				for (const int32 BindingIndex : Bucket)
+				{
+					const uint32 SlotIndex = GetSlotIndex(KeyHashes[BindingIndex], Displacement);
+					if (UsedSlots[SlotIndex] || BucketSlots.Contains(SlotIndex))
+					{
+						bPlaced = false;
+						break;
+					}
+					BucketSlots.Add(SlotIndex);
+				}
+				if (bPlaced)
+					break;
+			}
+			if (!bPlaced)
+			{
+				return false;
+			}
+
+			Displacements[BucketIndex] = Displacement;
+			for (int32 Index = 0; Index < Bucket.Num(); ++Index)
+			{
+				UsedSlots[BucketSlots[Index]] = true;
+				Slots[BucketSlots[Index]] = {Bindings[Bucket[Index]]->GetKey().GetIndex(), static_cast<uint32>(Bucket[Index])};
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,15 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/SoftObjectLoading.h"
+
+#include "Engine/StreamableManager.h"
+
+namespace DI
+{
+	FStreamableManager& GetSoftObjectStreamableManager()
+	{
+		static FStreamableManager StreamableManager;
+		return StreamableManager;
+	}
+}
@@ -279,13 +279,13 @@ DEFINE_FUNCTION(UDiBlueprintFunctionLibrary::execTryResolveInterface)
 		FName BindingName = BindingNameProperty;
 		P_NATIVE_BEGIN;
 			DI::FBindingId BindingId(DI::FTypeId(InterfaceType.Get()), BindingName);
-			TSharedPtr<DI::FBinding> Binding = DiContextInterface->GetDiContainer().FindBinding(BindingId);
+			TSharedPtr<DI::FBinding> Binding = DiContextInterface->GetDiContainer().FindBinding(DI::FBindingKey(BindingId));
 			if (!Binding)
 			{
 				UE_LOG(LogDependencyInjection, Error, TEXT("Failed to resolve Interface Binding %s"), *BindingId.ToString());
 			}
 			TSharedPtr<DI::FUInterfaceBinding> InterfaceBinding = StaticCastSharedPtr<DI::FUInterfaceBinding>(Binding);
-			(*static_cast<UObject**>(RESULT_PARAM)) = InterfaceBinding ? InterfaceBinding->Resolve().GetObject() : nullptr;
+			(*static_cast<UObject**>(RESULT_PARAM)) = InterfaceBinding ? InterfaceBinding->ResolveUntyped().GetObject() : nullptr;
 		P_NATIVE_END;
 	}
 }
@@ -6,6 +6,13 @@
 #include "TentacleSettings.h"
 #include "Contexts/DiGameInstanceSubsystem.h"
 
+void UDiEngineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	DiContainerGCd->EnableTypeSlots();
+}
+
 bool UDiEngineSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
 	return GetDefault<UTentacleSettings>()->bEnableScopeSubsystems;
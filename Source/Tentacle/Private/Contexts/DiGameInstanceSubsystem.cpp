@@ -11,6 +11,8 @@ void UDiGameInstanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	DiContainerGCd->EnableTypeSlots();
+
 	if (!GetDefault<UTentacleSettings>()->bEnableDefaultChaining)
 		return;
 
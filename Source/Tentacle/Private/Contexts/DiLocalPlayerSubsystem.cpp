@@ -15,6 +15,8 @@ void UDiLocalPlayerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	DiContainerGCd->EnableTypeSlots();
+
 	ULocalPlayer* LocalPlayer = GetLocalPlayer();
 	PlayerControllerChanged(LocalPlayer->GetPlayerController(nullptr));
 
@@ -24,6 +24,8 @@ void UDiWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	DiContainerGCd->EnableTypeSlots();
+
 	if (!GetDefault<UTentacleSettings>()->bEnableDefaultChaining)
 		return;
 
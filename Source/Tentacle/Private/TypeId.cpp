@@ -7,15 +7,13 @@ const DI::FTypeId DI::FTypeId::InvalidId = FTypeId();
 
 FName DI::FTypeId::GetName() const
 {
-	switch (Type)
+	if (const FNativeTypeTag* NativeTypeTag = TryGetNativeTypeTag())
+	{
+		return NativeTypeTag->Name;
+	}
+	if (const UStruct* UType = TryGetUType())
 	{
-	case EIdType::Invalid:
-	default:
-		return TEXT("Invalid");
-	case EIdType::UType:
 		return UType->GetFName();
-		break;
-	case EIdType::NativeType:
-		return NativeClassId;
 	}
+	return TEXT("Invalid");
 }
@@ -25,4 +25,22 @@ namespace DI
 
 	/** Default implementation for reacting to EBindConflictBehavior */
 	TENTACLE_API void HandleBindingConflict(const FBindingId& BindingId, EBindConflictBehavior ConflictBehavior);
+
+	/**
+	 * Why a container did not accept a binding.
+	 */
+	enum class EBindRejectReason
+	{
+		// The container has been sealed and does not accept any new bindings.
+		Sealed,
+		// Static containers only hold unnamed bindings.
+		NamedBindingInStaticContainer,
+		// Static containers can not store type erased bindings. They have to be bound through Bind().
+		TypeErasedBindingInStaticContainer,
+		// The container can not hold multi bindings.
+		MultiBindingsUnsupported,
+	};
+
+	/** Reacts to a bind that the container does not accept the same way as to a binding conflict. */
+	TENTACLE_API void HandleBindingRejected(const FBindingId& BindingId, EBindRejectReason RejectReason, EBindConflictBehavior ConflictBehavior);
 }
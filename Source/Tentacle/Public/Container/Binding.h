@@ -1,84 +1,193 @@
 ﻿#pragma once
 #include "BindingId.h"
+#include "BindingKey.h"
 #include "TypeId.h"
-#include "StructUtils/InstancedStruct.h"
+#include "UObject/Class.h"
 
 namespace DI
 {
+	template <class T>
+	class TFactoryBinding;
+
+	/** How often the factory of a TFactoryBinding runs. */
+	enum class EFactoryLifetime : uint8
+	{
+		/** The factory runs on the first resolve and its instance is kept for all following resolves. */
+		Lazy,
+		/** The factory runs on every resolve, so every resolve gets its own instance. */
+		Transient,
+	};
+
+	/** Tag for constructing a binding whose instance is created later by a TFactoryBinding. */
+	struct FDeferredInstance
+	{
+	};
+
+	/**
+	 * The closed set of binding kinds. Matches the branches of TBindingType.
+	 * FBinding dispatches on this instead of virtual functions, so bindings have no vtable and the checks can be inlined.
+	 */
+	enum class EBindingKind : uint8
+	{
+		UObject,
+		UInterface,
+		UStruct,
+		Native,
+	};
+
 	/**
 	 * Common parent for all bindings.
 	 * This binding has no resolve-capabilities of its own but can do tracking for the Garbage Collector.
+	 * @note The destructor is not virtual. Bindings have to be destroyed through their concrete type, which MakeShared and FBindingArena do.
 	 */
 	class FBinding
 	{
 	public:
-		FBinding(FBindingId BindingId)
-			: Id(MoveTemp(BindingId))
+		FORCEINLINE FBindingId GetId() const
 		{
+			return Id;
 		}
 
-		virtual ~FBinding() = default;
+		FORCEINLINE FBindingKey GetKey() const
+		{
+			return Key;
+		}
 
-		FORCEINLINE FBindingId GetId() const
+		FORCEINLINE EBindingKind GetKind() const
 		{
-			return Id;
+			return Kind;
 		}
 
-		virtual void AddReferencedObjects(FReferenceCollector& Collector)
+		FORCEINLINE void AddReferencedObjects(FReferenceCollector& Collector);
+
+		FORCEINLINE bool IsValid() const;
+
+		/** @return true if resolving this binding runs the factory of a TFactoryBinding. */
+		FORCEINLINE bool IsResolvedByFactory() const
 		{
-			GetId().AddReferencedObjects(Collector);
+			return bResolvedByFactory;
 		}
 
-		virtual bool IsValid() const
+	protected:
+		FBinding(FKeyedBindingId BindingId, EBindingKind InKind)
+			: Id(MoveTemp(BindingId.Id)), Key(BindingId.Key), Kind(InKind)
 		{
-			return true;
 		}
 
+		~FBinding() = default;
+
+		/** Only call this if IsResolvedByFactory. Defined after TFactoryBinding. */
+		template <class T>
+		TBindingInstRef<T> ResolveWithFactory() const;
+
 	private:
+		template <class>
+		friend class TFactoryBinding;
+
 		FBindingId Id;
+		FBindingKey Key;
+		EBindingKind Kind;
+
+		// Lives in the padding after Kind, so it does not grow the binding.
+		mutable bool bResolvedByFactory = false;
 	};
 
 
 	/**
-	 *
-	 * @tparam T
+	 * Type erased part of TUObjectBinding.
 	 */
-	template <class T>
-	class TUObjectBinding final : public FBinding
+	class FUObjectBinding : public FBinding
 	{
 	public:
 		using Super = FBinding;
+		using FUntypedInstance = TObjectPtr<UObject>;
 
-		TObjectPtr<T> UObjectDependency;
+		TObjectPtr<UObject> UObjectDependency;
 
-		TUObjectBinding(FBindingId BindingId, TObjectPtr<T> InObject)
-			: Super(BindingId), UObjectDependency(MoveTemp(InObject))
+		FUObjectBinding(FKeyedBindingId BindingId, TObjectPtr<UObject> InObject)
+			: Super(BindingId, EBindingKind::UObject), UObjectDependency(MoveTemp(InObject))
 		{
-			static_assert(TIsDerivedFrom<T, UObject>::IsDerived);
-			checkf(
-				InObject.GetClass()->IsChildOf(static_cast<UClass*>(BindingId.GetBoundTypeId().TryGetUType())),
-				TEXT("%s is not derived from %s"),
-				*InObject.GetClass()->GetName(),
-				*BindingId.GetBoundTypeId().TryGetUType()->GetName()
-			);
 		}
 
-		virtual bool IsValid() const override
+		FORCEINLINE bool IsValid() const
 		{
 			return ::IsValid(UObjectDependency);
 		}
 
-		TObjectPtr<T> Resolve() const
+		/**
+		 * Resolve without knowing the bound class at compile time, e.g. from Blueprints.
+		 * Runs the factory of a TFactoryBinding like the typed Resolve does.
+		 */
+		TObjectPtr<UObject> ResolveUntyped() const
 		{
+			if (UNLIKELY(IsResolvedByFactory()))
+			{
+				return UntypedFactory(*this);
+			}
 			check(UObjectDependency);
 			return UObjectDependency;
 		}
 
-		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		FORCEINLINE void AddInstanceReferencedObjects(FReferenceCollector& Collector)
 		{
-			Super::AddReferencedObjects(Collector);
 			Collector.AddReferencedObject(UObjectDependency);
 		}
+
+	protected:
+		/** Set by TFactoryBinding, which is the only one that knows the type its factory returns. */
+		FUntypedInstance (*UntypedFactory)(const FBinding& Binding) = nullptr;
+	};
+
+	/**
+	 *
+	 * @tparam T
+	 */
+	template <class T>
+	class TUObjectBinding : public FUObjectBinding
+	{
+	public:
+		using Super = FUObjectBinding;
+
+		TUObjectBinding(FKeyedBindingId BindingId, TObjectPtr<T> InObject)
+			: Super(BindingId, InObject)
+		{
+			static_assert(TIsDerivedFrom<T, UObject>::IsDerived);
+			CheckInstanceType(InObject);
+		}
+
+		TObjectPtr<T> Resolve() const
+		{
+			if (UNLIKELY(IsResolvedByFactory()))
+			{
+				return ResolveWithFactory<T>();
+			}
+			check(UObjectDependency);
+			return TObjectPtr<T>(static_cast<T*>(UObjectDependency.Get()));
+		}
+
+	protected:
+		TUObjectBinding(FKeyedBindingId BindingId, FDeferredInstance)
+			: Super(BindingId, nullptr)
+		{
+		}
+
+		void SetInstance(TObjectPtr<T> InObject)
+		{
+			checkf(InObject, TEXT("%s can not be bound to null."), *GetId().ToString());
+			CheckInstanceType(InObject);
+			UObjectDependency = MoveTemp(InObject);
+		}
+
+	private:
+		void CheckInstanceType(const TObjectPtr<T>& InObject) const
+		{
+			checkf(
+				InObject.GetClass()->IsChildOf(static_cast<UClass*>(GetId().GetBoundTypeId().TryGetUType())),
+				TEXT("%s is not derived from %s"),
+				*InObject.GetClass()->GetName(),
+				*GetId().GetBoundTypeId().TryGetUType()->GetName()
+			);
+		}
 	};
 
 
@@ -86,66 +195,117 @@ namespace DI
 	{
 	public:
 		using Super = FBinding;
+		using FUntypedInstance = FScriptInterface;
 
 		FScriptInterface InterfaceDependency;
 
-		FUInterfaceBinding(FBindingId BindingId, const FScriptInterface& InInterface)
-			: Super(BindingId), InterfaceDependency(InInterface)
+		FUInterfaceBinding(FKeyedBindingId BindingId, const FScriptInterface& InInterface)
+			: Super(BindingId, EBindingKind::UInterface), InterfaceDependency(InInterface)
 		{
 		}
 
-		virtual bool IsValid() const override
+		FORCEINLINE bool IsValid() const
 		{
 			return ::IsValid(InterfaceDependency.GetObject());
 		}
 
-		const FScriptInterface& Resolve() const
+		/**
+		 * Resolve without knowing the bound interface at compile time, e.g. from Blueprints.
+		 * Runs the factory of a TFactoryBinding like the typed Resolve does.
+		 */
+		FScriptInterface ResolveUntyped() const
 		{
-			check(InterfaceDependency.GetObject())
+			if (UNLIKELY(IsResolvedByFactory()))
+			{
+				return UntypedFactory(*this);
+			}
+			check(InterfaceDependency.GetObject());
 			return InterfaceDependency;
 		}
 
-		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		FORCEINLINE void AddInstanceReferencedObjects(FReferenceCollector& Collector)
 		{
-			Super::AddReferencedObjects(Collector);
 			InterfaceDependency.AddReferencedObjects(Collector);
 		}
+
+	protected:
+		/** Set by TFactoryBinding, which is the only one that knows the type its factory returns. */
+		FUntypedInstance (*UntypedFactory)(const FBinding& Binding) = nullptr;
 	};
 
 	template <class T>
-	class TUInterfaceDependencyBinding final : public FUInterfaceBinding
+	class TUInterfaceDependencyBinding : public FUInterfaceBinding
 	{
 	public:
 		using Super = FUInterfaceBinding;
 
 
-		TUInterfaceDependencyBinding(FBindingId BindingId, const TScriptInterface<T>& InInterface)
+		TUInterfaceDependencyBinding(FKeyedBindingId BindingId, const TScriptInterface<T>& InInterface)
 			: Super(BindingId, InInterface)
 		{
 		}
 
+		/**
+		 * Hands out the interface pointer that was looked up when binding.
+		 * Constructing the TScriptInterface from the object would search the interface table of its class on every resolve.
+		 */
 		TScriptInterface<T> Resolve() const
 		{
-			return TScriptInterface<T>(InterfaceDependency.GetObject());
+			if (UNLIKELY(IsResolvedByFactory()))
+			{
+				return ResolveWithFactory<T>();
+			}
+			check(InterfaceDependency.GetObject());
+			TScriptInterface<T> Resolved;
+			static_cast<FScriptInterface&>(Resolved) = InterfaceDependency;
+			return Resolved;
+		}
+
+	protected:
+		TUInterfaceDependencyBinding(FKeyedBindingId BindingId, FDeferredInstance)
+			: Super(BindingId, FScriptInterface())
+		{
+		}
+
+		void SetInstance(const TScriptInterface<T>& InInterface)
+		{
+			checkf(InInterface.GetObject(), TEXT("%s can not be bound to null."), *GetId().ToString());
+			InterfaceDependency = InInterface;
 		}
 	};
 
 	template <class T>
-	class TSharedNativeDependencyBinding final : public FBinding
+	class TSharedNativeDependencyBinding : public FBinding
 	{
 	public:
 		using Super = FBinding;
 
-		TSharedRef<T> SharedNativeDependency;
+		/** Null while resolving runs the factory of a TFactoryBinding. */
+		TSharedPtr<T> SharedNativeDependency;
 
-		TSharedNativeDependencyBinding(FBindingId BindingId, TSharedRef<T> InSharedInstance)
-			: Super(BindingId), SharedNativeDependency(InSharedInstance)
+		TSharedNativeDependencyBinding(FKeyedBindingId BindingId, TSharedRef<T> InSharedInstance)
+			: Super(BindingId, EBindingKind::Native), SharedNativeDependency(InSharedInstance)
 		{
 		}
 
 		TSharedRef<T> Resolve() const
 		{
-			return SharedNativeDependency;
+			if (UNLIKELY(IsResolvedByFactory()))
+			{
+				return ResolveWithFactory<T>();
+			}
+			return SharedNativeDependency.ToSharedRef();
+		}
+
+	protected:
+		TSharedNativeDependencyBinding(FKeyedBindingId BindingId, FDeferredInstance)
+			: Super(BindingId, EBindingKind::Native)
+		{
+		}
+
+		void SetInstance(TSharedRef<T> InSharedInstance)
+		{
+			SharedNativeDependency = MoveTemp(InSharedInstance);
 		}
 	};
 
@@ -157,12 +317,13 @@ namespace DI
 	public:
 		using Super = FBinding;
 
-		FRawDataBinding(FBindingId BindingId)
-			: Super(BindingId)
+		FORCEINLINE void CopyRawData(void* OutData, int32 SizeOfOutData);
+
+	protected:
+		FRawDataBinding(FKeyedBindingId BindingId, EBindingKind InKind)
+			: Super(BindingId, InKind)
 		{
 		}
-
-		virtual void CopyRawData(void* OutData, int32 SizeOfOutData) = 0;
 	};
 
 
@@ -175,36 +336,84 @@ namespace DI
 	public:
 		using Super = FRawDataBinding;
 
+		/** Structs up to this size and alignment are stored inline in the binding. Larger ones are allocated on the heap. */
+		static constexpr int32 InlineStructSize = 64;
+		static constexpr int32 InlineStructAlignment = 16;
+
 		FUStructBinding(UScriptStruct* StructType, FName BindingName, const uint8* StructMemoryToCopy)
-			: Super(FBindingId(FTypeId(StructType), BindingName))
+			: FUStructBinding(FBindingId(FTypeId(StructType), BindingName), StructType, StructMemoryToCopy)
+		{
+		}
+
+		FUStructBinding(FKeyedBindingId BindingId, UScriptStruct* StructType, const uint8* StructMemoryToCopy)
+			: Super(MoveTemp(BindingId), EBindingKind::UStruct),
+			  ScriptStruct(StructType),
+			  bInline(FitsInline(StructType))
 		{
-			StructData.InitializeAs(StructType, StructMemoryToCopy);
+			if (!bInline)
+			{
+				HeapData = static_cast<uint8*>(FMemory::Malloc(StructType->GetStructureSize(), StructType->GetMinAlignment()));
+			}
+			uint8* Memory = GetMutableMemory();
+			StructType->InitializeStruct(Memory);
+			StructType->CopyScriptStruct(Memory, StructMemoryToCopy);
 		}
 
-		const UScriptStruct* GetStruct()
+		FUStructBinding(const FUStructBinding&) = delete;
+		FUStructBinding& operator=(const FUStructBinding&) = delete;
+
+		~FUStructBinding()
 		{
-			return StructData.GetScriptStruct();
+			uint8* Memory = GetMutableMemory();
+			ScriptStruct->DestroyStruct(Memory);
+			if (!bInline)
+			{
+				FMemory::Free(Memory);
+			}
 		}
 
-		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		FORCEINLINE const UScriptStruct* GetStruct() const
 		{
-			Super::AddReferencedObjects(Collector);
-			StructData.AddStructReferencedObjects(Collector);
+			return ScriptStruct;
 		}
 
-		virtual void CopyRawData(void* OutData, int32 OutDataSize) override
+		FORCEINLINE void AddInstanceReferencedObjects(FReferenceCollector& Collector)
 		{
-			const UScriptStruct* StructClass = GetStruct();
-			check(StructClass->GetStructureSize() <= OutDataSize);
-			StructClass->CopyScriptStruct(OutData, StructData.GetMemory(), 1);
+			Collector.AddReferencedObject(ScriptStruct);
+			Collector.AddPropertyReferencesWithStructARO(ScriptStruct, GetMutableMemory());
+		}
+
+		void CopyStructData(void* OutData, int32 OutDataSize)
+		{
+			check(ScriptStruct->GetStructureSize() <= OutDataSize);
+			ScriptStruct->CopyScriptStruct(OutData, GetMemory(), 1);
 		};
 
+		FORCEINLINE const uint8* GetMemory() const
+		{
+			return bInline ? InlineData : HeapData;
+		}
+
 	protected:
-		/**
-		 * Manages the inner struct data.
-		 * We could inline the data to avoid the secondary allocation, but we would basically reimplement FInstancedStruct.
-		 */
-		FInstancedStruct StructData;
+		FORCEINLINE uint8* GetMutableMemory()
+		{
+			return bInline ? InlineData : HeapData;
+		}
+
+		static bool FitsInline(const UScriptStruct* StructType)
+		{
+			return StructType->GetStructureSize() <= InlineStructSize && StructType->GetMinAlignment() <= InlineStructAlignment;
+		}
+
+		TObjectPtr<const UScriptStruct> ScriptStruct;
+		bool bInline;
+
+		/** Small structs live in the binding itself, which saves the allocation and the pointer chase on resolve. */
+		union
+		{
+			alignas(InlineStructAlignment) uint8 InlineData[InlineStructSize];
+			uint8* HeapData;
+		};
 	};
 
 	/**
@@ -217,18 +426,58 @@ namespace DI
 	public:
 		using Super = FUStructBinding;
 
-		TTypedStructBinding(FBindingId BindingId, const T& InInstance)
-			: Super(T::StaticStruct(), BindingId.GetBindingName(), reinterpret_cast<const uint8*>(&InInstance))
+		TTypedStructBinding(FKeyedBindingId BindingId, const T& InInstance)
+			: Super(BindingId, T::StaticStruct(), reinterpret_cast<const uint8*>(&InInstance))
 		{
-			checkf(T::StaticStruct() == BindingId.GetBoundTypeId().TryGetUType(), TEXT("Inherited struct types are not supported at this moment"));
+			checkf(T::StaticStruct() == BindingId.Id.GetBoundTypeId().TryGetUType(), TEXT("Inherited struct types are not supported at this moment"));
 		}
 
 		const T& Resolve() const
 		{
-			return StructData.Get<T>();
+			return *reinterpret_cast<const T*>(GetMemory());
 		}
 	};
 
+	FORCEINLINE void FBinding::AddReferencedObjects(FReferenceCollector& Collector)
+	{
+		Id.AddReferencedObjects(Collector);
+		switch (Kind)
+		{
+		case EBindingKind::UObject:
+			static_cast<FUObjectBinding*>(this)->AddInstanceReferencedObjects(Collector);
+			break;
+		case EBindingKind::UInterface:
+			static_cast<FUInterfaceBinding*>(this)->AddInstanceReferencedObjects(Collector);
+			break;
+		case EBindingKind::UStruct:
+			static_cast<FUStructBinding*>(this)->AddInstanceReferencedObjects(Collector);
+			break;
+		case EBindingKind::Native:
+			break;
+		}
+	}
+
+	FORCEINLINE bool FBinding::IsValid() const
+	{
+		switch (Kind)
+		{
+		case EBindingKind::UObject:
+			return bResolvedByFactory || static_cast<const FUObjectBinding*>(this)->IsValid();
+		case EBindingKind::UInterface:
+			return bResolvedByFactory || static_cast<const FUInterfaceBinding*>(this)->IsValid();
+		case EBindingKind::UStruct:
+		case EBindingKind::Native:
+		default:
+			return true;
+		}
+	}
+
+	FORCEINLINE void FRawDataBinding::CopyRawData(void* OutData, int32 SizeOfOutData)
+	{
+		checkSlow(GetKind() == EBindingKind::UStruct);
+		static_cast<FUStructBinding*>(this)->CopyStructData(OutData, SizeOfOutData);
+	}
+
 
 	template <class T>
 	using TBindingType = DI::TBindingInstanceTypeSwitch<
@@ -237,4 +486,109 @@ namespace DI
 		TUInterfaceDependencyBinding<T>, // IInterface
 		TTypedStructBinding<T>, // UStruct
 		TSharedNativeDependencyBinding<T>>; // Native
+
+	/**
+	 * Binding that creates its instance with a factory when it is resolved.
+	 * Lazy bindings run the factory on the first resolve and keep the instance afterward. The factory is released after it ran.
+	 * Transient bindings run the factory on every resolve and never keep an instance.
+	 * Until an instance is kept the binding counts as valid, so containers hand it out like any other binding and waiting for it completes.
+	 *
+	 * Factories of UObjects and interfaces may return null while they can not create the instance yet, e.g. because it is not loaded.
+	 * Resolving returns null then and asks the factory again next time. An instance request lets WaitFor make the instance available.
+	 * UStructs are plain data and can not be created by a factory.
+	 * @note Resolve from the game thread only. The factory must not resolve its own binding.
+	 * @note UObjects captured by the factory are not referenced by the binding. Capture them weakly or keep them alive elsewhere.
+	 */
+	template <class T>
+	class TFactoryBinding final : public TBindingType<T>
+	{
+		static_assert(!TModels<CStaticStructProvider, T>::Value, "UStruct bindings can not be created by a factory.");
+
+	public:
+		using Super = TBindingType<T>;
+		using FFactory = TUniqueFunction<TBindingInstRef<T>()>;
+
+		/** Starts making the instance available, e.g. by loading it, and calls OnReady once the factory can create it. */
+		using FInstanceRequest = TFunction<void(TFunction<void()> OnReady)>;
+
+		TFactoryBinding(FKeyedBindingId BindingId, FFactory InFactory, EFactoryLifetime InLifetime = EFactoryLifetime::Lazy)
+			: Super(BindingId, FDeferredInstance())
+			, Factory(MoveTemp(InFactory))
+			, Lifetime(InLifetime)
+		{
+			check(Factory);
+			this->bResolvedByFactory = true;
+			if constexpr (THasUClass<T>::Value)
+			{
+				// Lets FUObjectBinding::ResolveUntyped and FUInterfaceBinding::ResolveUntyped run the factory.
+				this->UntypedFactory = [](const FBinding& Binding) -> typename Super::FUntypedInstance
+				{
+					return static_cast<const TFactoryBinding&>(Binding).ResolveWithFactory();
+				};
+			}
+		}
+
+		EFactoryLifetime GetLifetime() const
+		{
+			return Lifetime;
+		}
+
+		void SetInstanceRequest(FInstanceRequest InInstanceRequest)
+		{
+			InstanceRequest = MoveTemp(InInstanceRequest);
+		}
+
+		/** @return true if the factory has not created its instance and can be asked to make it available. */
+		bool CanRequestInstance() const
+		{
+			return this->IsResolvedByFactory() && InstanceRequest;
+		}
+
+		/** Runs the instance request. OnReady is called once the instance can be resolved. */
+		void RequestInstance(TFunction<void()> OnReady) const
+		{
+			check(CanRequestInstance());
+			InstanceRequest(MoveTemp(OnReady));
+		}
+
+	private:
+		friend class FBinding;
+
+		TBindingInstRef<T> ResolveWithFactory() const
+		{
+			TFactoryBinding& MutableThis = const_cast<TFactoryBinding&>(*this);
+			if (Lifetime == EFactoryLifetime::Transient)
+			{
+				return MutableThis.Factory();
+			}
+
+			checkf(!bConstructing, TEXT("The factory of %s resolves its own binding."), *this->GetId().ToString());
+			MutableThis.bConstructing = true;
+			TBindingInstRef<T> Instance = MutableThis.Factory();
+			MutableThis.bConstructing = false;
+			if constexpr (THasUClass<T>::Value)
+			{
+				if (!Instance)
+				{
+					return Instance;
+				}
+			}
+			MutableThis.SetInstance(Instance);
+			MutableThis.Factory.Reset();
+			MutableThis.InstanceRequest.Reset();
+			this->bResolvedByFactory = false;
+			return Super::Resolve();
+		}
+
+		FFactory Factory;
+		FInstanceRequest InstanceRequest;
+		EFactoryLifetime Lifetime;
+		bool bConstructing = false;
+	};
+
+	template <class T>
+	TBindingInstRef<T> FBinding::ResolveWithFactory() const
+	{
+		return static_cast<const TFactoryBinding<T>*>(this)->ResolveWithFactory();
+	}
 }
@@ -0,0 +1,84 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Binding.h"
+#include "Templates/RefCounting.h"
+
+namespace DI
+{
+	/**
+	 * Pooled allocator for the bindings of a single container.
+	 *
+	 * Bindings are placement constructed into slabs that grow geometrically, so the binding itself needs no heap allocation.
+	 * They are handed out as TSharedRefs with a custom deleter that hands their memory back to the arena.
+	 * Only the small reference controller is allocated by TSharedRef.
+	 *
+	 * The arena is not freed in one operation when its container dies. Bindings are shared and can outlive their container,
+	 * so every binding is destroyed as soon as its own last reference is released and its memory goes onto a free list
+	 * that later bindings of the same size reuse. The slabs are freed together once the container and its last binding are gone.
+	 * @note Emplace is not thread safe and expected to be called from the game thread. Bindings may be released on any thread.
+	 */
+	class TENTACLE_API FBindingArena : public FRefCountBase
+	{
+	public:
+		FBindingArena() = default;
+		virtual ~FBindingArena() override;
+
+		template <class TBinding, class... TArgs>
+		TSharedRef<TBinding> Emplace(TArgs&&... Args)
+		{
+			static_assert(TIsDerivedFrom<TBinding, FBinding>::Value, "Only bindings can be allocated from the binding arena.");
+			static_assert(alignof(TBinding) <= SlotAlignment, "Binding is over aligned for the binding arena.");
+			TBinding* Binding = new(Allocate(sizeof(TBinding))) TBinding(Forward<TArgs>(Args)...);
+			return TSharedRef<TBinding>(Binding, [](TBinding* ReleasedBinding)
+			{
+				// Bindings have no virtual destructor, so they have to be destroyed through their concrete type.
+				ReleasedBinding->~TBinding();
+				Free(ReleasedBinding);
+			});
+		}
+
+		/** @return the number of bindings of this arena that are alive. */
+		int32 Num() const
+		{
+			return NumBindings;
+		}
+
+	private:
+		static constexpr SIZE_T SlotAlignment = 16;
+		static constexpr SIZE_T InitialSlabSize = 256;
+		static constexpr SIZE_T MaxSlabSize = 4096;
+
+		/** Stored in front of every binding so it can find its way back to the arena. */
+		struct alignas(SlotAlignment) FSlotHeader
+		{
+			union
+			{
+				FBindingArena* Arena;
+				FSlotHeader* NextFree;
+			};
+			uint32 SlotSize;
+		};
+
+		struct FFreeList
+		{
+			uint32 SlotSize;
+			FSlotHeader* Head;
+		};
+
+		void* Allocate(SIZE_T Size);
+
+		/** Hand the memory of a destroyed binding back to the arena that allocated it. */
+		static void Free(void* Memory);
+
+		FCriticalSection CriticalSection;
+		TArray<FFreeList, TInlineAllocator<4>> FreeLists;
+		TArray<uint8*, TInlineAllocator<4>> Slabs;
+		uint8* Cursor = nullptr;
+		uint8* SlabEnd = nullptr;
+		SIZE_T NextSlabSize = InitialSlabSize;
+		int32 NumBindings = 0;
+	};
+}
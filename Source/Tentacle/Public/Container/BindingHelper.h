@@ -3,10 +3,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Async.h"
 #include "BindResult.h"
 #include "BindConflictBehavior.h"
 #include "DiContainerConcept.h"
 #include "Binding.h"
+#include "BindingName.h"
+#include "InstancePool.h"
+#include "SoftObjectLoading.h"
+#include "Engine/StreamableManager.h"
+#include "WeakFuture.h"
 
 namespace DI
 {
@@ -42,22 +48,198 @@ namespace DI
 		 * Resolving via its parent class is not supported.
 		 * If you need to resolve a binding by multiple types, you can bind it to all required types manually.
 		 */
-		template <class T>
+		template <class T, class TName>
 		EBindResult NamedInstance(
 			DI::TBindingInstRef<T> Instance,
-			const FName& InstanceName,
+			const TName& InstanceName,
 			EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
 		{
 			FBindingId BindingId = MakeBindingId<T>(InstanceName);
 			return this->RegisterBinding<T>(BindingId, Instance, ConflictBehavior);
 		}
 
+		/**
+		 * Adds an instance to the instances bound for T. Any number of instances can be added this way.
+		 * They never conflict with each other or with the binding of Instance<T> and are resolved all at once with Resolve().All<T>().
+		 * Only UObjects, interfaces and native types can be multi bound.
+		 * @code
+		 * DiContainer.Bind().MultiInstance<UDamageModifier>(ArmorModifier);
+		 * DiContainer.Bind().MultiInstance<UDamageModifier>(ShieldModifier);
+		 * @endcode
+		 * @return EBindResult::Rejected if the container is sealed or can not hold multi bindings, EBindResult::Bound otherwise.
+		 */
+		template <class T>
+		EBindResult MultiInstance(DI::TBindingInstRef<T> Instance, EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterMulti<T>(MakeBindingKey<T>(), Instance, ConflictBehavior);
+		}
+
+		/**
+		 * Adds an instance to the named instances bound for T.
+		 * @see MultiInstance
+		 */
+		template <class T, class TName>
+		EBindResult NamedMultiInstance(
+			DI::TBindingInstRef<T> Instance,
+			const TName& InstanceName,
+			EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterMulti<T>(MakeBindingKey<T>(InstanceName), Instance, ConflictBehavior);
+		}
+
+
+		/**
+		 * Binds a factory that creates the instance the first time it is resolved.
+		 * Services that are never resolved are never created. Subscribers that wait for the binding are served right away,
+		 * which runs the factory when binding.
+		 * Static DI containers can not hold factories and reject them.
+		 * @code
+		 * DiContainer.Bind().Factory<USimpleUService>([]{ return NewObject<USimpleUService>(); });
+		 * @endcode
+		 * @param Factory - callable returning a DI::TBindingInstRef<T>. Runs at most once.
+		 */
+		template <class T, class TFactory>
+		EBindResult Factory(TFactory&& Factory, EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterFactory<T>(MakeBindingId<T>(), Forward<TFactory>(Factory), ConflictBehavior);
+		}
+
+		/**
+		 * Binds a factory for a named binding that creates the instance the first time it is resolved.
+		 * @see Factory
+		 */
+		template <class T, class TName, class TFactory>
+		EBindResult NamedFactory(
+			TFactory&& Factory,
+			const TName& InstanceName,
+			EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterFactory<T>(MakeBindingId<T>(InstanceName), Forward<TFactory>(Factory), ConflictBehavior);
+		}
+
+		/**
+		 * Binds a transient binding that hands out its own instance on every resolve.
+		 * Instances are drawn from the pool, which the container shares ownership of.
+		 * Native instances go back into the pool when their last reference is released.
+		 * UObject instances have to be returned with TObjectInstancePool::Release.
+		 * @code
+		 * TSharedRef<DI::TInstancePool<UProjectileHelper>> Pool = MakeShared<DI::TInstancePool<UProjectileHelper>>();
+		 * DiContainer.Bind().Transient<UProjectileHelper>(Pool);
+		 * @endcode
+		 * @param Pool - pool that creates and recycles the instances. Can be shared between bindings and containers.
+		 */
+		template <class T>
+		EBindResult Transient(TSharedRef<TInstancePool<T>> Pool, EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterTransient<T>(MakeBindingId<T>(), MoveTemp(Pool), ConflictBehavior);
+		}
+
+		/**
+		 * Binds a transient binding of a native type with a pool of its own.
+		 * UObjects need a pool that is passed in, because nobody could return instances to a pool of the binding.
+		 * @see Transient
+		 */
+		template <class T>
+		EBindResult Transient(EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			static_assert(!THasUClass<T>::Value,
+				"UObject instances have to be released to their pool. Pass in the pool that you release them to.");
+			return this->RegisterTransient<T>(MakeBindingId<T>(), MakeShared<TInstancePool<T>>(), ConflictBehavior);
+		}
+
+		/**
+		 * Binds a named transient binding that hands out its own instance on every resolve.
+		 * @see Transient
+		 */
+		template <class T, class TName>
+		EBindResult NamedTransient(
+			TSharedRef<TInstancePool<T>> Pool,
+			const TName& InstanceName,
+			EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterTransient<T>(MakeBindingId<T>(InstanceName), MoveTemp(Pool), ConflictBehavior);
+		}
+
+		/**
+		 * Binds a soft reference to an object without loading it.
+		 * Resolving synchronously returns the object if it is loaded and null otherwise.
+		 * Waiting for the binding loads the object asynchronously and completes once it has been loaded.
+		 * Once resolved, the binding keeps the object loaded like any other binding.
+		 * @code
+		 * DiContainer.Bind().SoftObject<UAudioBankAsset>(Settings->AudioBank);
+		 * @endcode
+		 */
+		template <class T>
+		EBindResult SoftObject(const TSoftObjectPtr<T>& SoftObject, EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterSoft<T>(MakeBindingId<T>(), SoftObject, ConflictBehavior);
+		}
+
+		/**
+		 * Binds a named soft reference to an object without loading it.
+		 * @see SoftObject
+		 */
+		template <class T, class TName>
+		EBindResult NamedSoftObject(
+			const TSoftObjectPtr<T>& SoftObject,
+			const TName& InstanceName,
+			EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterSoft<T>(MakeBindingId<T>(InstanceName), SoftObject, ConflictBehavior);
+		}
+
+		/**
+		 * Binds a soft reference to a class without loading it. All classes are bound as UClass, so the binding needs a name.
+		 * @code
+		 * DiContainer.Bind().NamedSoftClass(Settings->HudWidgetClass, "HudWidgetClass");
+		 * TObjectPtr<UClass> HudWidgetClass = DiContainer.Resolve().TryGetNamed<UClass>("HudWidgetClass");
+		 * @endcode
+		 * @see SoftObject
+		 */
+		template <class T, class TName>
+		EBindResult NamedSoftClass(
+			const TSoftClassPtr<T>& SoftClass,
+			const TName& InstanceName,
+			EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterSoft<UClass>(MakeBindingId<UClass>(InstanceName), SoftClass, ConflictBehavior);
+		}
+
+		/**
+		 * Binds a native instance that is created by a factory on a background worker, so expensive construction does not hitch the game thread.
+		 * The instance is bound on the game thread once the factory has finished, which completes WaitFor and the async inject APIs.
+		 * Until then resolving the binding synchronously finds nothing.
+		 * The factory must not touch UObjects or anything else that is not thread safe.
+		 * @code
+		 * DiContainer->Bind().AsyncFactory<FNavigationCache>([NavData = MoveTemp(NavData)] { return MakeShared<FNavigationCache>(NavData); });
+		 * @endcode
+		 * @param Factory - callable returning a TSharedRef<T>.
+		 * @return a future with the result of binding the instance. It is canceled if the container is destroyed before the factory finishes.
+		 */
+		template <class T, class TFactory>
+		TWeakFuture<EBindResult> AsyncFactory(TFactory&& Factory, EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterAsyncFactory<T>(NAME_None, Forward<TFactory>(Factory), ConflictBehavior);
+		}
+
+		/**
+		 * Binds a named native instance that is created by a factory on a background worker.
+		 * @see AsyncFactory
+		 */
+		template <class T, class TName, class TFactory>
+		TWeakFuture<EBindResult> NamedAsyncFactory(
+			TFactory&& Factory,
+			const TName& InstanceName,
+			EBindConflictBehavior ConflictBehavior = GDefaultConflictBehavior)
+		{
+			return this->RegisterAsyncFactory<T>(InstanceName, Forward<TFactory>(Factory), ConflictBehavior);
+		}
 
 	private:
 		template <class T>
-		TSharedPtr<DI::TBindingType<T>> FindBinding(const FBindingId& BindingId) const
+		TSharedPtr<DI::TBindingType<T>> FindBinding(const FBindingKey& BindingKey) const
 		{
-			if (const TSharedPtr<DI::FBinding> DependencyBinding = DiContainer.FindBinding(BindingId))
+			if (const TSharedPtr<DI::FBinding> DependencyBinding = DiContainer.FindBinding(BindingKey))
 			{
 				return StaticCastSharedPtr<DI::TBindingType<T>>(DependencyBinding);
 			}
@@ -72,8 +254,111 @@ namespace DI
 		                            DI::TBindingInstRef<T> Instance,
 		                            EBindConflictBehavior ConflictBehavior)
 		{
-			TSharedRef<DI::TBindingType<T>> ConcreteBinding = MakeShared<DI::TBindingType<T>>(BindingId, Instance);
-			return DiContainer.BindSpecific(ConcreteBinding, ConflictBehavior);
+			if constexpr (CBindingEmplacer<TDiContainer, T>)
+			{
+				return DiContainer.template EmplaceBinding<T>(BindingId, Instance, ConflictBehavior);
+			}
+			else
+			{
+				TSharedRef<DI::TBindingType<T>> ConcreteBinding = MakeShared<DI::TBindingType<T>>(BindingId, Instance);
+				return DiContainer.BindSpecific(ConcreteBinding, ConflictBehavior);
+			}
+		}
+
+		template <class T>
+		EBindResult RegisterMulti(const FBindingKey& BindingKey, DI::TBindingInstRef<T> Instance, EBindConflictBehavior ConflictBehavior)
+		{
+			if constexpr (CMultiBindingProvider<TDiContainer>)
+			{
+				return DiContainer.BindMulti(MakeShared<DI::TMultiBinding<T>>(BindingKey, Instance), ConflictBehavior);
+			}
+			else
+			{
+				HandleBindingRejected(BindingKey.GetId(), EBindRejectReason::MultiBindingsUnsupported, ConflictBehavior);
+				return EBindResult::Rejected;
+			}
+		}
+
+		/**
+		 * Factories are bound once and usually not in hot code, so they are heap allocated instead of emplaced.
+		 */
+		template <class T, class TFactory>
+		EBindResult RegisterFactory(
+			const FBindingId& BindingId,
+			TFactory&& Factory,
+			EBindConflictBehavior ConflictBehavior,
+			EFactoryLifetime Lifetime = EFactoryLifetime::Lazy)
+		{
+			TSharedRef<DI::TFactoryBinding<T>> FactoryBinding = MakeShared<DI::TFactoryBinding<T>>(
+				BindingId, typename DI::TFactoryBinding<T>::FFactory(Forward<TFactory>(Factory)), Lifetime);
+			return DiContainer.BindSpecific(FactoryBinding, ConflictBehavior);
+		}
+
+		template <class T>
+		EBindResult RegisterTransient(const FBindingId& BindingId, TSharedRef<TInstancePool<T>> Pool, EBindConflictBehavior ConflictBehavior)
+		{
+			static_assert(!std::is_void_v<TInstancePool<T>>, "Only UObjects and native types can be bound as transient.");
+			return this->RegisterFactory<T>(BindingId, [Pool = MoveTemp(Pool)] { return Pool->Acquire(); }, ConflictBehavior, EFactoryLifetime::Transient);
+		}
+
+		/**
+		 * Soft bindings are lazy factories that can not create their instance until it is loaded.
+		 * The factory only looks the object up, loading is left to the instance request that WaitFor runs.
+		 */
+		template <class T, class TSoftPtr>
+		EBindResult RegisterSoft(const FBindingId& BindingId, const TSoftPtr& SoftPtr, EBindConflictBehavior ConflictBehavior)
+		{
+			static_assert(TIsDerivedFrom<T, UObject>::Value, "Only UObjects can be bound softly.");
+			TSharedRef<DI::TFactoryBinding<T>> SoftBinding = MakeShared<DI::TFactoryBinding<T>>(
+				BindingId,
+				[SoftPtr] { return TObjectPtr<T>(SoftPtr.Get()); });
+			SoftBinding->SetInstanceRequest([ObjectPath = SoftPtr.ToSoftObjectPath()](TFunction<void()> OnReady)
+			{
+				GetSoftObjectStreamableManager().RequestAsyncLoad(ObjectPath, FStreamableDelegate::CreateLambda(MoveTemp(OnReady)));
+			});
+			return DiContainer.BindSpecific(SoftBinding, ConflictBehavior);
+		}
+
+		/**
+		 * Rejections and conflicts with bindings of the container are detected before starting the factory so no work is wasted on them.
+		 * Bindings of ancestors do not conflict, the result shadows them like any other binding.
+		 * Bindings that are added while the factory runs are detected when binding its result.
+		 */
+		template <class T, class TFactory>
+		TWeakFuture<EBindResult> RegisterAsyncFactory(const FName& BindingName, TFactory&& Factory, EBindConflictBehavior ConflictBehavior)
+		{
+			static_assert(!HasUStruct<T>(), "Only native types can be created off the game thread.");
+			static_assert(TIsDerivedFrom<TDiContainer, TSharedFromThis<TDiContainer>>::Value,
+				"Async factories need a DI container that is owned by a shared pointer.");
+			static_assert(CBindingChecker<TDiContainer>, "Async factories need a DI container that can check its bindings before the factory starts.");
+			check(IsInGameThread());
+
+			auto [Promise, Future] = MakeWeakPromisePair<EBindResult>();
+			const EBindResult EarlyResult = DiContainer.CanBind(MakeBindingKey<T>(BindingName), ConflictBehavior);
+			if (EarlyResult != EBindResult::Bound)
+			{
+				Promise.EmplaceValue(EarlyResult);
+				return MoveTemp(Future);
+			}
+
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+				[WeakDiContainer = DiContainer.AsWeak(), BindingName, ConflictBehavior, Factory = TUniqueFunction<TSharedRef<T>()>(Forward<TFactory>(Factory)), Promise = MoveTemp(Promise)]() mutable
+				{
+					TSharedRef<T> Instance = Factory();
+					AsyncTask(ENamedThreads::GameThread,
+						[WeakDiContainer = MoveTemp(WeakDiContainer), BindingName, ConflictBehavior, Instance = MoveTemp(Instance), Promise = MoveTemp(Promise)]() mutable
+						{
+							if (TSharedPtr<TDiContainer> PinnedDiContainer = WeakDiContainer.Pin())
+							{
+								Promise.EmplaceValue(PinnedDiContainer->Bind().template NamedInstance<T>(Instance, BindingName, ConflictBehavior));
+							}
+							else
+							{
+								Promise.Cancel();
+							}
+						});
+				});
+			return MoveTemp(Future);
 		}
 
 	private:
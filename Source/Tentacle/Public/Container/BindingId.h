@@ -58,13 +58,13 @@ namespace DI
 	}
 
 	template <class T>
-	static FBindingId MakeBindingId()
+	FBindingId MakeBindingId()
 	{
 		return FBindingId(DI::GetTypeId<T>());
 	}
 
 	template <class T>
-	static FBindingId MakeBindingId(FName BindingName)
+	FBindingId MakeBindingId(FName BindingName)
 	{
 		return FBindingId(DI::GetTypeId<T>(), MoveTemp(BindingName));
 	}
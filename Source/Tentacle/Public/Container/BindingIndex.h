@@ -0,0 +1,538 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BindingKey.h"
+
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+#define DI_BINDING_INDEX_SSE2 1
+#include <emmintrin.h>
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#define DI_BINDING_INDEX_NEON 1
+#if PLATFORM_WINDOWS
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifndef DI_BINDING_INDEX_SSE2
+#define DI_BINDING_INDEX_SSE2 0
+#endif
+#ifndef DI_BINDING_INDEX_NEON
+#define DI_BINDING_INDEX_NEON 0
+#endif
+
+namespace DI
+{
+	namespace Private
+	{
+		/** Control byte states. Full slots store the 7 bit H2 hash, so their high bit is always clear. */
+		enum class EBindingIndexCtrl : uint8
+		{
+			Empty = 0x80,
+			Deleted = 0xFE,
+		};
+
+		/**
+		 * Bit mask of matching slots in a probe group.
+		 * The SSE2 and scalar variants use one bit per slot, NEON uses one nibble per slot.
+		 */
+		class FBindingIndexGroupMask
+		{
+		public:
+#if DI_BINDING_INDEX_NEON
+			using FMaskType = uint64;
+			static constexpr uint32 Shift = 2;
+#else
+			using FMaskType = uint32;
+			static constexpr uint32 Shift = 0;
+#endif
+
+			explicit FBindingIndexGroupMask(FMaskType InMask) : Mask(InMask)
+			{
+			}
+
+			FORCEINLINE explicit operator bool() const
+			{
+				return Mask != 0;
+			}
+
+			FORCEINLINE uint32 LowestSlot() const
+			{
+#if DI_BINDING_INDEX_NEON
+				return static_cast<uint32>(FMath::CountTrailingZeros64(Mask)) >> Shift;
+#else
+				return FMath::CountTrailingZeros(Mask);
+#endif
+			}
+
+			FORCEINLINE void ClearLowest()
+			{
+				Mask &= Mask - 1;
+			}
+
+		private:
+			FMaskType Mask;
+		};
+
+		/** 16 control bytes that are matched against in a single instruction where SIMD is available. */
+		struct FBindingIndexGroup
+		{
+			static constexpr uint32 Width = 16;
+
+			explicit FBindingIndexGroup(const uint8* Ctrl)
+#if DI_BINDING_INDEX_SSE2
+				: Data(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Ctrl)))
+#elif DI_BINDING_INDEX_NEON
+				: Data(vld1q_u8(Ctrl))
+#else
+				: Data(Ctrl)
+#endif
+			{
+			}
+
+			FORCEINLINE FBindingIndexGroupMask Match(uint8 H2) const
+			{
+#if DI_BINDING_INDEX_SSE2
+				return FBindingIndexGroupMask(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(H2)), Data))));
+#elif DI_BINDING_INDEX_NEON
+				return FromNeonCompare(vceqq_u8(vdupq_n_u8(H2), Data));
+#else
+				uint32 Mask = 0;
+				for (uint32 Slot = 0; Slot < Width; ++Slot)
+				{
+					Mask |= static_cast<uint32>(Data[Slot] == H2) << Slot;
+				}
+				return FBindingIndexGroupMask(Mask);
+#endif
+			}
+
+			FORCEINLINE FBindingIndexGroupMask MatchEmpty() const
+			{
+				return Match(static_cast<uint8>(EBindingIndexCtrl::Empty));
+			}
+
+			/** Both Empty and Deleted have the high bit set, which is what we test for here. */
+			FORCEINLINE FBindingIndexGroupMask MatchEmptyOrDeleted() const
+			{
+#if DI_BINDING_INDEX_SSE2
+				return FBindingIndexGroupMask(static_cast<uint32>(_mm_movemask_epi8(Data)));
+#elif DI_BINDING_INDEX_NEON
+				return FromNeonCompare(vcltzq_s8(vreinterpretq_s8_u8(Data)));
+#else
+				uint32 Mask = 0;
+				for (uint32 Slot = 0; Slot < Width; ++Slot)
+				{
+					Mask |= static_cast<uint32>((Data[Slot] & 0x80) != 0) << Slot;
+				}
+				return FBindingIndexGroupMask(Mask);
+#endif
+			}
+
+		private:
+#if DI_BINDING_INDEX_NEON
+			/** NEON has no movemask, so narrow each 0xFF/0x00 byte lane to a nibble and keep a single bit per nibble. */
+			static FORCEINLINE FBindingIndexGroupMask FromNeonCompare(uint8x16_t Compare)
+			{
+				const uint8x8_t Narrowed = vshrn_n_u16(vreinterpretq_u16_u8(Compare), 4);
+				return FBindingIndexGroupMask(vget_lane_u64(vreinterpret_u64_u8(Narrowed), 0) & 0x8888888888888888ull);
+			}
+#endif
+
+#if DI_BINDING_INDEX_SSE2
+			__m128i Data;
+#elif DI_BINDING_INDEX_NEON
+			uint8x16_t Data;
+#else
+			const uint8* Data;
+#endif
+		};
+	}
+
+	/**
+	 * Open addressing hash table from FBindingKey to TValue used as the binding storage of the DI containers.
+	 *
+	 * Slots are organized in groups of 16. Every slot has a control byte that is either empty, deleted or holds 7 bits of the key's hash.
+	 * A lookup compares all control bytes of a group against the hash in a single SSE2/NEON instruction and only touches the
+	 * keys of slots whose control byte matched. Keys and values are kept in flat arrays next to each other so a hit costs one
+	 * control byte load, one key compare and one value load.
+	 *
+	 * @tparam TValue - the value type. Values are constructed and destroyed in place and moved when the table grows.
+	 */
+	template <class TValue>
+	class TBindingIndex
+	{
+		using FGroup = Private::FBindingIndexGroup;
+		using ECtrl = Private::EBindingIndexCtrl;
+		static constexpr uint32 GroupWidth = FGroup::Width;
+
+	public:
+		TBindingIndex() = default;
+
+		TBindingIndex(const TBindingIndex& Other)
+		{
+			*this = Other;
+		}
+
+		TBindingIndex(TBindingIndex&& Other)
+		{
+			*this = MoveTemp(Other);
+		}
+
+		~TBindingIndex()
+		{
+			Empty();
+		}
+
+		TBindingIndex& operator=(const TBindingIndex& Other)
+		{
+			if (this != &Other)
+			{
+				Empty();
+				Reserve(Other.Num());
+				for (auto It = Other.CreateConstIterator(); It; ++It)
+				{
+					Emplace(It.Key(), It.Value());
+				}
+			}
+			return *this;
+		}
+
+		TBindingIndex& operator=(TBindingIndex&& Other)
+		{
+			if (this != &Other)
+			{
+				Empty();
+				Ctrl = Other.Ctrl;
+				Keys = Other.Keys;
+				Values = Other.Values;
+				Capacity = Other.Capacity;
+				NumElements = Other.NumElements;
+				NumDeleted = Other.NumDeleted;
+				Other.Ctrl = nullptr;
+				Other.Keys = nullptr;
+				Other.Values = nullptr;
+				Other.Capacity = 0;
+				Other.NumElements = 0;
+				Other.NumDeleted = 0;
+			}
+			return *this;
+		}
+
+		FORCEINLINE int32 Num() const
+		{
+			return static_cast<int32>(NumElements);
+		}
+
+		/** @return pointer to the value bound to Key or nullptr if there is none. */
+		FORCEINLINE TValue* Find(const FBindingKey& Key)
+		{
+			const int32 Slot = FindSlot(Key);
+			return Slot != INDEX_NONE ? &Values[Slot] : nullptr;
+		}
+
+		FORCEINLINE const TValue* Find(const FBindingKey& Key) const
+		{
+			return const_cast<TBindingIndex*>(this)->Find(Key);
+		}
+
+		FORCEINLINE bool Contains(const FBindingKey& Key) const
+		{
+			return FindSlot(Key) != INDEX_NONE;
+		}
+
+		/** Start loading the first probe group of Key so a Find for it shortly after does not stall on memory. */
+		FORCEINLINE void Prefetch(const FBindingKey& Key) const
+		{
+			if (Capacity == 0)
+				return;
+
+			const uint32 GroupStart = (H1(Hash(Key)) & (Capacity / GroupWidth - 1)) * GroupWidth;
+			FPlatformMisc::Prefetch(Ctrl + GroupStart);
+			FPlatformMisc::Prefetch(Keys + GroupStart);
+		}
+
+		/**
+		 * Add a value for Key, replacing the value that is already bound to Key.
+		 * @return reference to the value in the table. Only valid until the next modification.
+		 */
+		template <class... TArgs>
+		TValue& Emplace(const FBindingKey& Key, TArgs&&... Args)
+		{
+			checkf(Key.IsValid(), TEXT("Can not add an invalid binding key to a binding index."));
+			int32 Slot = FindSlot(Key);
+			if (Slot != INDEX_NONE)
+			{
+				Values[Slot].~TValue();
+				return *new(&Values[Slot]) TValue(Forward<TArgs>(Args)...);
+			}
+
+			if (NumElements + NumDeleted + 1 > MaxLoad(Capacity))
+			{
+				Rehash(NumElements + 1);
+			}
+
+			Slot = FindInsertSlot(Hash(Key));
+			if (Ctrl[Slot] == static_cast<uint8>(ECtrl::Deleted))
+			{
+				--NumDeleted;
+			}
+			Ctrl[Slot] = H2(Hash(Key));
+			Keys[Slot] = Key;
+			++NumElements;
+			return *new(&Values[Slot]) TValue(Forward<TArgs>(Args)...);
+		}
+
+		/** @return true if there was a value bound to Key. */
+		bool Remove(const FBindingKey& Key)
+		{
+			const int32 Slot = FindSlot(Key);
+			if (Slot == INDEX_NONE)
+				return false;
+
+			Values[Slot].~TValue();
+			--NumElements;
+
+			// A group that still has an empty slot terminates all probes passing through it, so we can mark the slot as empty again.
+			// Otherwise we have to leave a tombstone so probes for keys in later groups keep going.
+			const uint32 GroupStart = Slot & ~(GroupWidth - 1);
+			if (FGroup(Ctrl + GroupStart).MatchEmpty())
+			{
+				Ctrl[Slot] = static_cast<uint8>(ECtrl::Empty);
+			}
+			else
+			{
+				Ctrl[Slot] = static_cast<uint8>(ECtrl::Deleted);
+				++NumDeleted;
+			}
+			return true;
+		}
+
+		/** Remove all values but keep the memory for reuse. */
+		void Reset()
+		{
+			DestroyValues();
+			if (Ctrl)
+			{
+				FMemory::Memset(Ctrl, static_cast<uint8>(ECtrl::Empty), Capacity);
+			}
+			NumElements = 0;
+			NumDeleted = 0;
+		}
+
+		/** Make sure that NumElements can be added without growing the table. */
+		void Reserve(int32 NumElementsToReserve)
+		{
+			if (static_cast<uint32>(NumElementsToReserve) > MaxLoad(Capacity))
+			{
+				Rehash(static_cast<uint32>(NumElementsToReserve));
+			}
+		}
+
+		/** Remove all values and free all memory. */
+		void Empty()
+		{
+			DestroyValues();
+			FreeTable(Ctrl, Keys, Values);
+			Ctrl = nullptr;
+			Keys = nullptr;
+			Values = nullptr;
+			Capacity = 0;
+			NumElements = 0;
+			NumDeleted = 0;
+		}
+
+		template <bool bConst>
+		class TBaseIterator
+		{
+			using FTablePtr = std::conditional_t<bConst, const TBindingIndex*, TBindingIndex*>;
+			using FValueRef = std::conditional_t<bConst, const TValue&, TValue&>;
+
+		public:
+			explicit TBaseIterator(FTablePtr InTable) : Table(InTable)
+			{
+				SkipToFull();
+			}
+
+			FORCEINLINE explicit operator bool() const
+			{
+				return Slot < Table->Capacity;
+			}
+
+			FORCEINLINE TBaseIterator& operator++()
+			{
+				++Slot;
+				SkipToFull();
+				return *this;
+			}
+
+			FORCEINLINE const FBindingKey& Key() const
+			{
+				return Table->Keys[Slot];
+			}
+
+			FORCEINLINE FValueRef Value() const
+			{
+				return Table->Values[Slot];
+			}
+
+		private:
+			void SkipToFull()
+			{
+				while (Slot < Table->Capacity && (Table->Ctrl[Slot] & 0x80) != 0)
+				{
+					++Slot;
+				}
+			}
+
+			FTablePtr Table;
+			uint32 Slot = 0;
+		};
+
+		using TIterator = TBaseIterator<false>;
+		using TConstIterator = TBaseIterator<true>;
+
+		TIterator CreateIterator()
+		{
+			return TIterator(this);
+		}
+
+		TConstIterator CreateConstIterator() const
+		{
+			return TConstIterator(this);
+		}
+
+	private:
+		/** Binding key indices are dense, so they are spread with a multiplicative hash before being split into H1 and H2. */
+		static FORCEINLINE uint32 Hash(const FBindingKey& Key)
+		{
+			return Key.GetIndex() * 0x9E3779B1u;
+		}
+
+		/** Selects the group to start probing at. */
+		static FORCEINLINE uint32 H1(uint32 KeyHash)
+		{
+			return KeyHash >> 7;
+		}
+
+		/** Stored in the control byte to filter slots before comparing keys. */
+		static FORCEINLINE uint8 H2(uint32 KeyHash)
+		{
+			return static_cast<uint8>(KeyHash & 0x7F);
+		}
+
+		/** Keep at least 1/8 of the slots empty so every probe sequence terminates quickly. */
+		static FORCEINLINE uint32 MaxLoad(uint32 InCapacity)
+		{
+			return InCapacity - InCapacity / 8;
+		}
+
+		FORCEINLINE int32 FindSlot(const FBindingKey& Key) const
+		{
+			if (Capacity == 0)
+				return INDEX_NONE;
+
+			const uint32 KeyHash = Hash(Key);
+			const uint8 KeyH2 = H2(KeyHash);
+			const uint32 GroupMask = Capacity / GroupWidth - 1;
+			uint32 GroupIndex = H1(KeyHash) & GroupMask;
+			// Triangular probing over groups visits every group exactly once because the number of groups is a power of two.
+			for (uint32 ProbeStep = 1; ; ++ProbeStep)
+			{
+				const uint32 GroupStart = GroupIndex * GroupWidth;
+				const FGroup Group(Ctrl + GroupStart);
+				for (Private::FBindingIndexGroupMask Match = Group.Match(KeyH2); Match; Match.ClearLowest())
+				{
+					const uint32 Slot = GroupStart + Match.LowestSlot();
+					if (LIKELY(Keys[Slot] == Key))
+					{
+						return static_cast<int32>(Slot);
+					}
+				}
+				if (LIKELY(Group.MatchEmpty()))
+				{
+					return INDEX_NONE;
+				}
+				GroupIndex = (GroupIndex + ProbeStep) & GroupMask;
+			}
+		}
+
+		int32 FindInsertSlot(uint32 KeyHash) const
+		{
+			const uint32 GroupMask = Capacity / GroupWidth - 1;
+			uint32 GroupIndex = H1(KeyHash) & GroupMask;
+			for (uint32 ProbeStep = 1; ; ++ProbeStep)
+			{
+				const uint32 GroupStart = GroupIndex * GroupWidth;
+				if (Private::FBindingIndexGroupMask Free = FGroup(Ctrl + GroupStart).MatchEmptyOrDeleted())
+				{
+					return static_cast<int32>(GroupStart + Free.LowestSlot());
+				}
+				GroupIndex = (GroupIndex + ProbeStep) & GroupMask;
+			}
+		}
+
+		void Rehash(uint32 MinNumElements)
+		{
+			uint32 NewCapacity = GroupWidth;
+			while (MaxLoad(NewCapacity) < MinNumElements)
+			{
+				NewCapacity *= 2;
+			}
+
+			uint8* OldCtrl = Ctrl;
+			FBindingKey* OldKeys = Keys;
+			TValue* OldValues = Values;
+			const uint32 OldCapacity = Capacity;
+
+			Capacity = NewCapacity;
+			Ctrl = static_cast<uint8*>(FMemory::Malloc(Capacity, GroupWidth));
+			FMemory::Memset(Ctrl, static_cast<uint8>(ECtrl::Empty), Capacity);
+			Keys = static_cast<FBindingKey*>(FMemory::Malloc(Capacity * sizeof(FBindingKey), alignof(FBindingKey)));
+			Values = static_cast<TValue*>(FMemory::Malloc(Capacity * sizeof(TValue), alignof(TValue)));
+			NumDeleted = 0;
+
+			for (uint32 Slot = 0; Slot < OldCapacity; ++Slot)
+			{
+				if ((OldCtrl[Slot] & 0x80) != 0)
+					continue;
+
+				const uint32 KeyHash = Hash(OldKeys[Slot]);
+				const int32 NewSlot = FindInsertSlot(KeyHash);
+				Ctrl[NewSlot] = H2(KeyHash);
+				Keys[NewSlot] = OldKeys[Slot];
+				new(&Values[NewSlot]) TValue(MoveTemp(OldValues[Slot]));
+				OldValues[Slot].~TValue();
+			}
+
+			FreeTable(OldCtrl, OldKeys, OldValues);
+		}
+
+		void DestroyValues()
+		{
+			for (uint32 Slot = 0; Slot < Capacity; ++Slot)
+			{
+				if ((Ctrl[Slot] & 0x80) == 0)
+				{
+					Values[Slot].~TValue();
+				}
+			}
+		}
+
+		static void FreeTable(uint8* InCtrl, FBindingKey* InKeys, TValue* InValues)
+		{
+			FMemory::Free(InCtrl);
+			FMemory::Free(InKeys);
+			FMemory::Free(InValues);
+		}
+
+		uint8* Ctrl = nullptr;
+		FBindingKey* Keys = nullptr;
+		TValue* Values = nullptr;
+		uint32 Capacity = 0;
+		uint32 NumElements = 0;
+		uint32 NumDeleted = 0;
+	};
+}
@@ -0,0 +1,149 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BindingId.h"
+
+namespace DI
+{
+	/**
+	 * Compact interned handle for a FBindingId.
+	 * Every distinct (FTypeId, FName) pair is registered once in a process wide registry and receives a dense index.
+	 * Comparing and hashing keys is a single integer operation, so containers use keys instead of FBindingIds for bind, resolve and notify.
+	 *
+	 * Unnamed and named bindings are numbered separately. The index of an unnamed key is the dense type slot of its type,
+	 * which containers can use to index an array directly. Named keys have the NamedFlag bit set.
+	 * @note The registry never shrinks. The number of distinct binding ids in a process is expected to be small.
+	 * It does not keep UStructs alive. A UStruct that is garbage collected keeps its keys, but a new type at the same address gets new ones.
+	 */
+	class TENTACLE_API FBindingKey
+	{
+	public:
+		FBindingKey() = default;
+
+		/**
+		 * Interns the binding id.
+		 * This takes a lock on the registry, so cache keys where possible instead of creating them over and over again.
+		 */
+		explicit FBindingKey(const FBindingId& BindingId);
+
+		FORCEINLINE bool IsValid() const
+		{
+			return Index != InvalidIndex;
+		}
+
+		FORCEINLINE uint32 GetIndex() const
+		{
+			return Index;
+		}
+
+		/** @return true if this key belongs to a binding with a name other than NAME_None. */
+		FORCEINLINE bool IsNamed() const
+		{
+			return (Index & NamedFlag) != 0;
+		}
+
+		/**
+		 * @return the dense, process wide slot of the bound type. Starts at 1.
+		 * Only meaningful for unnamed keys.
+		 */
+		FORCEINLINE uint32 GetTypeSlot() const
+		{
+			checkSlow(!IsNamed());
+			return Index;
+		}
+
+		/**
+		 * @return the binding id this key has been interned from.
+		 * Returns an invalid id if the bound UStruct has been garbage collected since.
+		 */
+		FBindingId GetId() const;
+
+		/** Describes the binding id this key has been interned from. Safe to call after the bound UStruct has been garbage collected. */
+		FString ToString() const;
+
+		FORCEINLINE bool operator==(const FBindingKey& Other) const
+		{
+			return Index == Other.Index;
+		}
+
+		FORCEINLINE bool operator!=(const FBindingKey& Other) const
+		{
+			return Index != Other.Index;
+		}
+
+		/** Keys are dense and unique so the index already is a collision free hash. */
+		friend FORCEINLINE uint32 GetTypeHash(const FBindingKey& Key)
+		{
+			return Key.Index;
+		}
+
+		static constexpr uint32 NamedFlag = 1u << 31;
+
+	private:
+		static constexpr uint32 InvalidIndex = 0;
+
+		uint32 Index = InvalidIndex;
+	};
+
+	static_assert(sizeof(FBindingKey) == sizeof(uint32));
+
+	/**
+	 * Binding id together with its interned key.
+	 * Converts implicitly from a FBindingId, which interns the key.
+	 * Code that already interned the key passes both, so the key is not interned again.
+	 */
+	struct FKeyedBindingId
+	{
+		FKeyedBindingId(const FBindingId& InId)
+			: Id(InId), Key(InId)
+		{
+		}
+
+		FKeyedBindingId(const FBindingId& InId, const FBindingKey& InKey)
+			: Id(InId), Key(InKey)
+		{
+			checkSlow(Key == FBindingKey(Id));
+		}
+
+		FBindingId Id;
+		FBindingKey Key;
+	};
+
+	/**
+	 * @return the interned key for the unnamed binding of T.
+	 * The key is only interned once per type.
+	 */
+	template <class T>
+	FBindingKey MakeBindingKey()
+	{
+		static const FBindingKey StaticBindingKey = FBindingKey(MakeBindingId<T>());
+		return StaticBindingKey;
+	}
+
+	/**
+	 * @return the interned key for the named binding of T.
+	 * Named keys are interned on every call, which takes the registry lock.
+	 * Named bindings that are resolved often should use a TBindingName instead, which interns its key once per type.
+	 */
+	template <class T>
+	FBindingKey MakeBindingKey(const FName& BindingName)
+	{
+		if (BindingName.IsNone())
+		{
+			return MakeBindingKey<T>();
+		}
+		return FBindingKey(MakeBindingId<T>(BindingName));
+	}
+
+	/**
+	 * @return the dense type slot of T.
+	 * @see FBindingKey::GetTypeSlot
+	 */
+	template <class T>
+	FORCEINLINE uint32 GetTypeSlot()
+	{
+		return MakeBindingKey<T>().GetTypeSlot();
+	}
+}
@@ -0,0 +1,126 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BindingKey.h"
+
+namespace DI
+{
+	/**
+	 * Bloom filter over binding keys.
+	 * Connected containers use it to summarize the keys bound in themselves and all of their ancestors,
+	 * so lookups for keys that are bound nowhere in the chain can be answered without walking it.
+	 *
+	 * Reset sizes the filter for a number of keys, which keeps false positives at about half a percent.
+	 * Keys can not be removed and the filter does not grow by itself. Once more keys have been added than it has been sized for,
+	 * IsOverloaded returns true and the owner should Reset it to a larger size and add its keys again.
+	 * An overloaded filter only costs false positives, never false negatives.
+	 *
+	 * Keys select their bits with the top bits of fixed 32 bit hashes, so filters of different sizes can be merged.
+	 */
+	class TENTACLE_API FBindingKeyFilter
+	{
+	public:
+		FBindingKeyFilter()
+		{
+			Words.SetNumZeroed(MinNumWords);
+		}
+
+		/** Drop all keys and size the filter for NumExpectedKeys keys. */
+		void Reset(int32 NumExpectedKeys);
+
+		FORCEINLINE void Add(const FBindingKey& Key)
+		{
+			const FProbes Probes(Key);
+			for (uint32 ProbeIndex = 0; ProbeIndex < NumProbes; ++ProbeIndex)
+			{
+				SetBit(Probes.Get(ProbeIndex) >> Shift);
+			}
+			++NumKeys;
+		}
+
+		/** @return false if the key has definitely never been added. */
+		FORCEINLINE bool MayContain(const FBindingKey& Key) const
+		{
+			const FProbes Probes(Key);
+			for (uint32 ProbeIndex = 0; ProbeIndex < NumProbes; ++ProbeIndex)
+			{
+				if (!IsBitSet(Probes.Get(ProbeIndex) >> Shift))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * Add all keys of the other filter.
+		 * A larger filter is folded into this one without any loss. The bits of a smaller filter are spread over all bits they stand for,
+		 * which keeps the false positive rate of the smaller filter for its keys.
+		 */
+		void Union(const FBindingKeyFilter& Other);
+
+		/** @return the number of keys added since the last Reset, including the keys of merged filters. Keys that have been added twice count twice. */
+		FORCEINLINE int32 Num() const
+		{
+			return NumKeys;
+		}
+
+		/** @return true if more keys have been added than the filter has been sized for. */
+		FORCEINLINE bool IsOverloaded() const
+		{
+			return NumKeys > GetNumBits() / BitsPerKey;
+		}
+
+		FORCEINLINE int32 GetNumBits() const
+		{
+			return Words.Num() * 64;
+		}
+
+	private:
+		static constexpr int32 BitsPerKey = 16;
+		static constexpr uint32 NumProbes = 3;
+		static constexpr uint32 MinNumBitsLog2 = 9;
+		static constexpr int32 MinNumWords = (1 << MinNumBitsLog2) / 64;
+
+		/** Binding key indices are dense, so they are mixed before the probes are derived from them by double hashing. */
+		struct FProbes
+		{
+			FORCEINLINE explicit FProbes(const FBindingKey& Key)
+			{
+				uint64 Hash = (static_cast<uint64>(Key.GetIndex()) + 1) * 0x9E3779B97F4A7C15ull;
+				Hash ^= Hash >> 32;
+				Hash *= 0xD6E8FEB86659FD93ull;
+				Hash ^= Hash >> 32;
+				First = static_cast<uint32>(Hash >> 32);
+				Step = static_cast<uint32>(Hash) | 1;
+			}
+
+			FORCEINLINE uint32 Get(uint32 ProbeIndex) const
+			{
+				return First + ProbeIndex * Step;
+			}
+
+			uint32 First;
+			uint32 Step;
+		};
+
+		FORCEINLINE void SetBit(uint32 Bit)
+		{
+			Words.GetData()[Bit / 64] |= uint64(1) << (Bit % 64);
+		}
+
+		FORCEINLINE bool IsBitSet(uint32 Bit) const
+		{
+			return (Words.GetData()[Bit / 64] & (uint64(1) << (Bit % 64))) != 0;
+		}
+
+		TArray<uint64, TInlineAllocator<MinNumWords>> Words;
+
+		// Probes are shifted down to the top log2(GetNumBits()) bits.
+		uint32 Shift = 32 - MinNumBitsLog2;
+
+		int32 NumKeys = 0;
+	};
+}
@@ -0,0 +1,111 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BindingId.h"
+#include "BindingKey.h"
+
+namespace DI
+{
+	namespace Private
+	{
+		/** String literal that can be passed as a template argument. */
+		template <SIZE_T N>
+		struct TBindingNameLiteral
+		{
+			constexpr TBindingNameLiteral(const ANSICHAR (&InChars)[N])
+			{
+				for (SIZE_T Index = 0; Index < N; ++Index)
+				{
+					Chars[Index] = InChars[Index];
+				}
+			}
+
+			ANSICHAR Chars[N] = {};
+		};
+	}
+
+	/**
+	 * Binding name that is known at compile time.
+	 * Passing a string literal as a binding name creates an FName and interns the binding key on every call.
+	 * A TBindingName creates its FName once and its binding key once per bound type.
+	 * It can be passed everywhere a binding name is accepted.
+	 * @code
+	 * using FSimpleServiceName = DI::TBindingName<"SimpleService">;
+	 * DiContainer.Bind().NamedInstance<USimpleUService>(Service, FSimpleServiceName());
+	 * DiContainer.Resolve().TryGetNamed<USimpleUService>(FSimpleServiceName());
+	 * DiContainer.Inject().AsyncIntoUObjectNamed(*this, &UExampleComponent::InjectDependencies, FSimpleServiceName());
+	 * @endcode
+	 */
+	template <Private::TBindingNameLiteral Name>
+	struct TBindingName
+	{
+		static const FName& GetName()
+		{
+			static const FName StaticName = FName(Name.Chars);
+			return StaticName;
+		}
+
+		/** @return the binding id of the binding of T with this name. */
+		template <class T>
+		static const FBindingId& GetId()
+		{
+			static const FBindingId StaticBindingId = MakeBindingId<T>(GetName());
+			return StaticBindingId;
+		}
+
+		/** @return the interned key of the binding of T with this name. */
+		template <class T>
+		static FBindingKey GetKey()
+		{
+			static const FBindingKey StaticBindingKey = FBindingKey(GetId<T>());
+			return StaticBindingKey;
+		}
+
+		/** Lets the token be used with APIs that only take FNames. */
+		operator FName() const
+		{
+			return GetName();
+		}
+	};
+
+	/**
+	 * Key of a named binding that is known at compile time.
+	 * @code
+	 * using FSimpleServiceKey = DI::TBindingKey<USimpleUService, "SimpleService">;
+	 * DiContainer.FindBinding(FSimpleServiceKey::GetKey());
+	 * @endcode
+	 * @see TBindingName
+	 */
+	template <class T, Private::TBindingNameLiteral Name>
+	struct TBindingKey
+	{
+		using FBoundType = T;
+		using FBindingName = TBindingName<Name>;
+
+		static const FBindingId& GetId()
+		{
+			return FBindingName::template GetId<T>();
+		}
+
+		static FBindingKey GetKey()
+		{
+			return FBindingName::template GetKey<T>();
+		}
+	};
+
+	/** @return the binding id of T for the compile time binding name. */
+	template <class T, Private::TBindingNameLiteral Name>
+	FORCEINLINE const FBindingId& MakeBindingId(TBindingName<Name>)
+	{
+		return TBindingName<Name>::template GetId<T>();
+	}
+
+	/** @return the binding key of T for the compile time binding name without interning it again. */
+	template <class T, Private::TBindingNameLiteral Name>
+	FORCEINLINE FBindingKey MakeBindingKey(TBindingName<Name>)
+	{
+		return TBindingName<Name>::template GetKey<T>();
+	}
+}
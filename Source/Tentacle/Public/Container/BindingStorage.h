@@ -0,0 +1,157 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Binding.h"
+#include "BindConflictBehavior.h"
+#include "BindingArena.h"
+#include "BindingIndex.h"
+#include "BindResult.h"
+#include "MultiBinding.h"
+#include "SealedBindingTable.h"
+
+namespace DI
+{
+	/**
+	 * Binding storage shared by the DI containers that own bindings.
+	 *
+	 * Bindings are kept in a TBindingIndex until the storage is sealed.
+	 * Sealing moves all bindings into a FSealedBindingTable and no more bindings may be added after that.
+	 *
+	 * With type slots enabled, unnamed bindings are stored in an array indexed by FBindingKey::GetTypeSlot instead,
+	 * which makes resolving them an array access without any hashing.
+	 * The array grows up to the highest type slot bound in this storage, so only enable this for long-lived containers.
+	 *
+	 * Bindings created through MakeBinding live in a FBindingArena owned by this storage.
+	 *
+	 * Multi bindings have a key space of their own, so they never conflict with the binding of the same key.
+	 * Sealing does not move them, but no more instances may be added to them after that.
+	 */
+	class TENTACLE_API FBindingStorage
+	{
+	public:
+		/** @return the binding stored for Key, or nullptr. The binding may be invalid. */
+		FORCEINLINE const TSharedPtr<FBinding>* Find(const FBindingKey& Key) const
+		{
+			if (bUseTypeSlots && !Key.IsNamed())
+			{
+				const uint32 TypeSlot = Key.GetTypeSlot();
+				return TypeSlot < static_cast<uint32>(TypeSlots.Num()) && TypeSlots.GetData()[TypeSlot].IsValid()
+					       ? &TypeSlots.GetData()[TypeSlot]
+					       : nullptr;
+			}
+			return bSealed ? SealedBindings.Find(Key) : Bindings.Find(Key);
+		}
+
+		/** Start loading the memory that Find(Key) is going to touch. Used when looking up many keys back to back. */
+		FORCEINLINE void Prefetch(const FBindingKey& Key) const
+		{
+			if (bUseTypeSlots && !Key.IsNamed())
+			{
+				const uint32 TypeSlot = Key.GetTypeSlot();
+				if (TypeSlot < static_cast<uint32>(TypeSlots.Num()))
+				{
+					FPlatformMisc::Prefetch(TypeSlots.GetData() + TypeSlot);
+				}
+			}
+			else if (bSealed)
+			{
+				SealedBindings.Prefetch(Key);
+			}
+			else
+			{
+				Bindings.Prefetch(Key);
+			}
+		}
+
+		/** Construct a binding in the arena of this storage. The binding is not added yet. */
+		template <class TBinding, class... TArgs>
+		TSharedRef<TBinding> MakeBinding(TArgs&&... Args)
+		{
+			if (!Arena.IsValid())
+			{
+				Arena = new FBindingArena();
+			}
+			return Arena->template Emplace<TBinding>(Forward<TArgs>(Args)...);
+		}
+
+		/**
+		 * Check whether a binding for Key can be added and report rejections and conflicts according to ConflictBehavior.
+		 * Bindings of other containers are no conflict, because containers may shadow the bindings of their ancestors.
+		 * @return EBindResult::Bound if the binding can be added.
+		 */
+		EBindResult CanAdd(const FBindingKey& Key, EBindConflictBehavior ConflictBehavior) const;
+
+		/** Add a binding or replace the binding with the same key. Must not be called on sealed storage. */
+		void Add(TSharedRef<FBinding> Binding);
+
+		/** @return the multi binding stored for Key, or nullptr. */
+		FORCEINLINE const FMultiBinding* FindMulti(const FBindingKey& Key) const
+		{
+			const TSharedPtr<FMultiBinding>* MultiBinding = MultiBindings.Find(Key);
+			return MultiBinding ? MultiBinding->Get() : nullptr;
+		}
+
+		/** Append the instances of MultiBinding to the multi binding with the same key. Must not be called on sealed storage. */
+		void AddMulti(TSharedRef<FMultiBinding> MultiBinding);
+
+		/** Freeze the current bindings into the sealed table. */
+		void Seal();
+
+		FORCEINLINE bool IsSealed() const
+		{
+			return bSealed;
+		}
+
+		/** Store unnamed bindings in a direct indexed array. Existing unnamed bindings are moved over. Must be called before sealing. */
+		void EnableTypeSlots();
+
+		FORCEINLINE bool UsesTypeSlots() const
+		{
+			return bUseTypeSlots;
+		}
+
+		int32 Num() const;
+
+		/** Call Function with the key of every binding in this storage. */
+		template <class TFunction>
+		void ForEachKey(TFunction&& Function) const
+		{
+			for (const TSharedPtr<FBinding>& Binding : TypeSlots)
+			{
+				if (Binding.IsValid())
+				{
+					Function(Binding->GetKey());
+				}
+			}
+			if (bSealed)
+			{
+				for (const TSharedPtr<FBinding>& Binding : SealedBindings.GetBindings())
+				{
+					Function(Binding->GetKey());
+				}
+			}
+			else
+			{
+				for (auto It = Bindings.CreateConstIterator(); It; ++It)
+				{
+					Function(It.Key());
+				}
+			}
+		}
+
+		void AddReferencedObjects(FReferenceCollector& Collector);
+
+	private:
+		TBindingIndex<TSharedPtr<FBinding>> Bindings = {};
+		FSealedBindingTable SealedBindings = {};
+		TArray<TSharedPtr<FBinding>> TypeSlots = {};
+		TBindingIndex<TSharedPtr<FMultiBinding>> MultiBindings = {};
+		int32 NumTypeSlotBindings = 0;
+		bool bSealed = false;
+		bool bUseTypeSlots = false;
+		// Created on the first MakeBinding so containers that never bind do not allocate it.
+		TRefCountPtr<FBindingArena> Arena;
+	};
+}
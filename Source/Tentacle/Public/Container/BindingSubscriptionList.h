@@ -4,7 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Binding.h"
-#include "BindingId.h"
+#include "BindingKey.h"
 
 namespace DI
 {
@@ -17,14 +17,14 @@ namespace DI
 		using FOnInstanceBound = TMulticastDelegate<void(const DI::FBinding&)>;
 		using FOnInstanceBoundUnicast = FOnInstanceBound::FDelegate;
 
-		bool Unsubscribe(const FBindingId& BindingId, FDelegateHandle DelegateHandle);
+		bool Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle);
 
 		void NotifyInstanceBound(const DI::FBinding& Binding);
 
-		FOnInstanceBound& SubscribeOnce(const FBindingId& BindingId);
-		TArray<FBindingId> GetAllPendingBindingIds() const;
+		FOnInstanceBound& SubscribeOnce(const FBindingKey& BindingKey);
+		TArray<FBindingKey> GetAllPendingBindingKeys() const;
 
 	private:
-		TMap<FBindingId, FOnInstanceBound> BindingToSubscriptions = {};
+		TMap<FBindingKey, FOnInstanceBound> BindingToSubscriptions = {};
 	};
 }
@@ -14,7 +14,8 @@ namespace DI
 	 * Binding will cause the container to notify its children that a new binding has been bound.
 	 * This behavior to prevent the memory overhead of duplicate bindings in favor of worse performance at bind and resolve time.
 	 *
-	 * Children do not cache bindings that have been bound in parent containers.
+	 * Children remember which binding an ancestor answered for a key, so repeated resolves of ancestor bindings are a single local probe.
+	 * The cache is dropped whenever anything is bound in this container or an ancestor, or whenever the parents of this container or an ancestor change.
 	 */
 	class TENTACLE_API FChainedDiContainer final
 		: public TSharedFromThis<FChainedDiContainer>
@@ -27,7 +28,7 @@ namespace DI
 		// Technically, we could have a copy constructor, but copying is usually a user error, so we delete it to catch these cases earlier.
 		FChainedDiContainer(const FChainedDiContainer&) = delete;
 
-		virtual ~FChainedDiContainer() override = default;
+		virtual ~FChainedDiContainer() override;
 
 		/**
 		 * Sets the chained parent of this DI Container.
@@ -38,6 +39,25 @@ namespace DI
 		/** Call this from the owning type to prevent types and bindings to be garbage collected. */
 		void AddReferencedObjects(FReferenceCollector& Collector);
 
+		/**
+		 * Freeze all bindings of this container into an immutable perfect hash table.
+		 * Binding into a sealed container is rejected with EBindResult::Rejected.
+		 * Parents are not affected and may still receive new bindings.
+		 * Use this for containers that are filled once and resolved from a lot afterward.
+		 */
+		void Seal();
+
+		/** @return true if Seal has been called and no more bindings can be added. */
+		bool IsSealed() const;
+
+		/**
+		 * Resolve unnamed bindings of this container by indexing an array with the type slot instead of hashing.
+		 * The array grows with the highest type slot that is bound, so use this for long-lived containers with many bindings.
+		 * The DI subsystems enable it for their scope containers, which live as long as their scope and are resolved from a lot.
+		 * Must be called before Seal.
+		 */
+		void EnableTypeSlots();
+
 		/** Get the Binding API */
 		TBindingHelper<FChainedDiContainer> Bind() { return TBindingHelper(*this); }
 		/** Get the Resolving API */
@@ -48,42 +68,123 @@ namespace DI
 		// - FDiContainerBase
 		/** Bind a specific binding. */
 		virtual EBindResult BindSpecific(TSharedRef<DI::FBinding> SpecificBinding, EBindConflictBehavior ConflictBehavior) override;
-		/** Find a binding by its ID. */
-		virtual TSharedPtr<DI::FBinding> FindBinding(const FBindingId& BindingId) const override;
+		/** Find a binding by its key. */
+		virtual TSharedPtr<DI::FBinding> FindBinding(const FBindingKey& BindingKey) const override;
+		/** Find a binding by its key without touching reference counts. */
+		virtual DI::FBinding* FindBorrowedBinding(const FBindingKey& BindingKey) const override;
+		/** Find the bindings of several keys with a single walk up the chain. */
+		virtual void FindBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const override;
 
 		/**
-		 * Get the delegate that will be invoked a single time when the binding with the given ID is bound.
+		 * Get the delegate that will be invoked a single time when the binding with the given key is bound.
 		 * If the binding is already bound the event will never fire.
-		 * @param BindingId the ID of the binding to be notified about.
+		 * @param BindingKey the key of the binding to be notified about.
 		 */
-		virtual FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingId& BindingId) const override;
+		virtual FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingKey& BindingKey) const override;
+		// --
+
+		// - CBindingEmplacer
+		/**
+		 * Construct the binding in the arena of this container and bind it.
+		 * Rejections and conflicts are checked first, so bindings that would not be bound are never constructed.
+		 * The id is only interned once for the check and the binding.
+		 */
+		template <class T>
+		EBindResult EmplaceBinding(const FBindingId& BindingId, TBindingInstRef<T> Instance, EBindConflictBehavior ConflictBehavior)
+		{
+			const FBindingKey BindingKey = FBindingKey(BindingId);
+			const EBindResult Result = Bindings.CanAdd(BindingKey, ConflictBehavior);
+			if (Result != EBindResult::Bound)
+			{
+				return Result;
+			}
+			AddBinding(Bindings.MakeBinding<TBindingType<T>>(FKeyedBindingId(BindingId, BindingKey), Instance));
+			return EBindResult::Bound;
+		}
+		// --
+
+		// - CBindingChecker
+		/** Check for rejections and conflicts with the bindings of this container and report them according to ConflictBehavior. */
+		EBindResult CanBind(const FBindingKey& BindingKey, EBindConflictBehavior ConflictBehavior) const;
+		// --
+
+		// - CMultiBindingProvider
+		/** Append the instances of the multi binding to the instances this container holds for its key. */
+		EBindResult BindMulti(TSharedRef<FMultiBinding> MultiBinding, EBindConflictBehavior ConflictBehavior);
+
+		/** Find the instances of this container followed by those of its ancestors. */
+		const FMultiBinding* FindMultiBinding(const FBindingKey& BindingKey) const;
 		// --
 
 		/**
 		 * Unsubscribe from being notified about a binding.
-		 * @param BindingId The ID of the binding where there is a subscription
+		 * @param BindingKey The key of the binding where there is a subscription
 		 * @param DelegateHandle The handle that was returned when the subscription was created
 		 * @return true if there was a subscription and it has been successfully removed.
 		 */
-		bool Unsubscribe(const FBindingId& BindingId, FDelegateHandle DelegateHandle) const;
+		bool Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle) const;
 
 	private:
 		// - FConnectedDiContainer
 		virtual bool TryConnectSubcontainer(TSharedRef<FConnectedDiContainer> ConnectedDiContainer) override;
 		virtual bool TryDisconnectSubcontainer(TSharedRef<FConnectedDiContainer> ConnectedDiContainer) override;
 		virtual void NotifyInstanceBound(const DI::FBinding& NewBinding) const override;
+		virtual void NotifyGraphChanged() const override;
+		virtual void NotifyMultiInstancesBound() const override;
 		virtual void RetryAllPendingWaits() const override;
-		virtual TSharedPtr<DI::FBinding> FindConnectedBinding(const DI::FBindingId& BindingId) const override;
+		virtual TSharedPtr<DI::FBinding> FindConnectedBinding(const DI::FBindingKey& BindingKey) const override;
+		virtual DI::FBinding* FindConnectedBorrowedBinding(const DI::FBindingKey& BindingKey) const override;
+		virtual void FindConnectedBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const override;
+		virtual const DI::FMultiBinding* FindConnectedMultiBinding(const DI::FBindingKey& BindingKey) const override;
+		virtual const FBindingKeyFilter& GetBindingFilter() const override;
 		// --
 
+		/**
+		 * Probes this container for all missing keys before passing the remaining ones on to the parent in one go.
+		 * @return true if there is a binding for every key.
+		 */
+		bool FindBorrowedBindingsInChain(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const;
+
+		/** Add a binding that passed FBindingStorage::CanAdd and notify this container and its children about it. */
+		void AddBinding(TSharedRef<DI::FBinding> Binding);
+
 		/** Our own registered Bindings */
-		TMap<FBindingId, TSharedRef<DI::FBinding>> Bindings = {};
+		FBindingStorage Bindings = {};
 
 		// mutable so we can use it in const resolve methods
 		mutable FBindingSubscriptionList Subscriptions;
 
 		TWeakPtr<FConnectedDiContainer> ParentContainer;
 
+		// Raw alias of ParentContainer so borrowed lookups can skip pinning. Only dereferenced while ParentContainer is valid.
+		FConnectedDiContainer* BorrowedParentContainer = nullptr;
+
+		/** @return the binding that an ancestor provides for BindingKey. Answers repeated lookups from AncestorCache. */
+		const TSharedPtr<DI::FBinding>* FindAncestorBinding(const FBindingKey& BindingKey) const;
+
+		/** Drops the AncestorCache if the graph or any binding changed since it was filled. */
+		void RefreshAncestorCache() const;
+
+		/** Bindings found in ancestors. Only valid while the generations below match. */
+		mutable TBindingIndex<TSharedPtr<DI::FBinding>> AncestorCache;
+		mutable uint32 AncestorCacheGraphGeneration = 0;
+		mutable uint32 AncestorCacheBindGeneration = 0;
+
+		/** Multi bindings of this container merged with those of its ancestors. Entries are merged again once the resolve generation changed. */
+		mutable TBindingIndex<FMergedMultiBinding> MergedMultiBindings;
+
+		/** Keys bound in this container and its ancestors. Lets lookups for keys that are bound nowhere skip the whole chain. */
+		mutable FBindingKeyFilter BindingFilter;
+
+		/** Size the BindingFilter for the keys of this container and its ancestors and fill it again. */
+		void RebuildBindingFilter() const;
+
+		/** Bumped for every binding that is bound in this container or any of its ancestors. */
+		mutable uint32 BindGeneration = 0;
+
+		/** Bumped whenever the parents of this container or any of its ancestors change, or an ancestor is destroyed. */
+		mutable uint32 GraphGeneration = 0;
+
 		// Mutable so we can clean up invalid children in getters
 		mutable TArray<TWeakPtr<FConnectedDiContainer>, TInlineAllocator<1>> ChildrenContainers;
 	};
@@ -93,6 +194,10 @@ namespace DI
 	static_assert(TModels<CTypeHasFindBinding, FChainedDiContainer>::Value);
 	static_assert(TModels<CTypeHasSubscribe, FChainedDiContainer>::Value);
 	static_assert(DiContainerConcept<FChainedDiContainer>);
+	static_assert(CBindingEmplacer<FChainedDiContainer, UObject>);
+	static_assert(CBorrowedBindingProvider<FChainedDiContainer>);
+	static_assert(CMultiBindingProvider<FChainedDiContainer>);
+	static_assert(CBindingChecker<FChainedDiContainer>);
 }
 
 
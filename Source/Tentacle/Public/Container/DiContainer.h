@@ -9,6 +9,7 @@
 #include "BindResult.h"
 #include "Binding.h"
 #include "BindingId.h"
+#include "BindingStorage.h"
 #include "DiContainerBase.h"
 #include "DiContainerConcept.h"
 #include "Injector.h"
@@ -26,28 +27,79 @@ namespace DI
 		/** Bind a specific binding. */
 		virtual EBindResult BindSpecific(TSharedRef<DI::FBinding> SpecificBinding, EBindConflictBehavior ConflictBehavior) override;
 
-		/** Find a binding by its ID. */
-		virtual TSharedPtr<DI::FBinding> FindBinding(const FBindingId& BindingId) const override;
+		/** Find a binding by its key. */
+		virtual TSharedPtr<DI::FBinding> FindBinding(const FBindingKey& BindingKey) const override;
+
+		/** Find a binding by its key without touching reference counts. */
+		virtual DI::FBinding* FindBorrowedBinding(const FBindingKey& BindingKey) const override;
+
+		/** Find the bindings of several keys without touching reference counts. */
+		virtual void FindBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const override;
 
 		/**
-		 * Get the delegate that will be invoked a single time when the binding with the given ID is bound.
+		 * Get the delegate that will be invoked a single time when the binding with the given key is bound.
 		 * If the binding is already bound the event will never fire.
-		 * @param BindingId the ID of the binding to be notified about.
+		 * @param BindingKey the key of the binding to be notified about.
 		 */
-		virtual FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingId& BindingId) const override;
+		virtual FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingKey& BindingKey) const override;
+		// --
+
+		// - CBindingEmplacer
+		/**
+		 * Construct the binding in the arena of this container and bind it.
+		 * Rejections and conflicts are checked first, so bindings that would not be bound are never constructed.
+		 * The id is only interned once for the check and the binding.
+		 */
+		template <class T>
+		EBindResult EmplaceBinding(const FBindingId& BindingId, TBindingInstRef<T> Instance, EBindConflictBehavior ConflictBehavior)
+		{
+			const FBindingKey BindingKey = FBindingKey(BindingId);
+			const EBindResult Result = Bindings.CanAdd(BindingKey, ConflictBehavior);
+			if (Result != EBindResult::Bound)
+			{
+				return Result;
+			}
+			AddBinding(Bindings.MakeBinding<TBindingType<T>>(FKeyedBindingId(BindingId, BindingKey), Instance));
+			return EBindResult::Bound;
+		}
+		// --
+
+		// - CMultiBindingProvider
+		/** Append the instances of the multi binding to the instances this container holds for its key. */
+		EBindResult BindMulti(TSharedRef<FMultiBinding> MultiBinding, EBindConflictBehavior ConflictBehavior);
+
+		/** Find the multi binding of this container for the key. */
+		const FMultiBinding* FindMultiBinding(const FBindingKey& BindingKey) const;
 		// --
 
 		/**
 		 * Unsubscribe from being notified about a binding.
-		 * @param BindingId The ID of the binding where there is a subscription
+		 * @param BindingKey The key of the binding where there is a subscription
 		 * @param DelegateHandle The handle that was returned when the subscription was created
 		 * @return true if there was a subscription and it has been successfully removed.
 		 */
-		bool Unsubscribe(const FBindingId& BindingId, FDelegateHandle DelegateHandle) const;
+		bool Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle) const;
 
 		/** Call this from the owning type to prevent types and bindings to be garbage collected. */
 		void AddReferencedObjects(FReferenceCollector& Collector);
 
+		/**
+		 * Freeze all current bindings into an immutable perfect hash table.
+		 * Binding into a sealed container is rejected with EBindResult::Rejected.
+		 * Use this for containers that are filled once and resolved from a lot afterward.
+		 */
+		void Seal();
+
+		/** @return true if Seal has been called and no more bindings can be added. */
+		bool IsSealed() const;
+
+		/**
+		 * Resolve unnamed bindings of this container by indexing an array with the type slot instead of hashing.
+		 * The array grows with the highest type slot that is bound, so use this for long-lived containers with many bindings.
+		 * Must be called before Seal.
+		 */
+		void EnableTypeSlots();
+
 		/** Get the Binding API */
 		TBindingHelper<FDiContainer> Bind();
 		/** Get the Resolving API */
@@ -55,7 +107,10 @@ namespace DI
 		/** Get the Injection API */
 		TInjector<FDiContainer> Inject();
 	protected:
-		TMap<FBindingId, TSharedRef<DI::FBinding>> Bindings = {};
+		/** Add a binding that passed FBindingStorage::CanAdd and notify everyone waiting for it. */
+		void AddBinding(TSharedRef<DI::FBinding> Binding);
+
+		FBindingStorage Bindings = {};
 		mutable FBindingSubscriptionList Subscriptions;
 	};
 
@@ -64,4 +119,7 @@ namespace DI
 	static_assert(TModels<CTypeHasFindBinding, FDiContainer>::Value);
 	static_assert(TModels<CTypeHasSubscribe, FDiContainer>::Value);
 	static_assert(DiContainerConcept<FDiContainer>);
+	static_assert(CBindingEmplacer<FDiContainer, UObject>);
+	static_assert(CBorrowedBindingProvider<FDiContainer>);
+	static_assert(CMultiBindingProvider<FDiContainer>);
 }
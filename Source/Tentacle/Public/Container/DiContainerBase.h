@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "BindConflictBehavior.h"
+#include "BindingKeyFilter.h"
 #include "BindResult.h"
 #include "DiContainerConcept.h"
 
@@ -22,16 +23,52 @@ namespace DI
 		// - DiContainerConcept
 		/** Bind a specific binding. */
 		virtual EBindResult BindSpecific(TSharedRef<DI::FBinding> SpecificBinding, EBindConflictBehavior ConflictBehavior) = 0;
-		/** Find a binding by its ID. */
-		virtual TSharedPtr<DI::FBinding> FindBinding(const FBindingId& BindingId) const = 0;
+		/** Find a binding by its key. */
+		virtual TSharedPtr<DI::FBinding> FindBinding(const FBindingKey& BindingKey) const = 0;
+		/**
+		 * Find a binding by its key without touching any reference counts.
+		 * The binding is only valid until the container or any of its parents is modified or destroyed,
+		 * so only read it right away on the game thread.
+		 */
+		virtual DI::FBinding* FindBorrowedBinding(const FBindingKey& BindingKey) const = 0;
+
+		/**
+		 * Find the bindings for several keys at once without touching any reference counts.
+		 * Connected containers walk their ancestors once for all keys instead of once per key.
+		 * @param BindingKeys - the keys to look for.
+		 * @param OutBindings - receives the binding of the key at the same index. Entries that are already set are skipped
+		 * and entries of keys that are not bound are left untouched.
+		 * @see FindBorrowedBinding
+		 */
+		virtual void FindBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const;
 
 		/**
-		 * Get the delegate that will be invoked a single time when the binding with the given ID is bound.
+		 * Get the delegate that will be invoked a single time when the binding with the given key is bound.
 		 * If the binding is already bound the event will never fire.
-		 * @param BindingId the ID of the binding to be notified about.
+		 * @param BindingKey the key of the binding to be notified about.
 		 */
-		virtual FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingId& BindingId) const = 0;
+		virtual FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingKey& BindingKey) const = 0;
 		// --
+
+		/**
+		 * Changes whenever a resolve from this container might return something else than before, which is when anything is bound
+		 * in this container or its ancestors or when the parents of this container or of an ancestor change.
+		 * Handles that cache resolved bindings only have to resolve again once this changed, @see TDiRef.
+		 * Containers that this container does not resolve through never change it.
+		 */
+		FORCEINLINE uint64 GetResolveGeneration() const
+		{
+			return ResolveGeneration;
+		}
+
+	protected:
+		FORCEINLINE void BumpResolveGeneration() const
+		{
+			++ResolveGeneration;
+		}
+
+	private:
+		mutable uint64 ResolveGeneration = 0;
 	};
 
 	/**
@@ -61,6 +98,19 @@ namespace DI
 		 */
 		virtual void NotifyInstanceBound(const DI::FBinding& NewBinding) const = 0;
 
+		/**
+		 * Notifies this connected container that the parents of this container or of one of its ancestors changed,
+		 * or that an ancestor has been destroyed.
+		 * Implementers drop everything they cached from their ancestors and pass the notification on to their children.
+		 */
+		virtual void NotifyGraphChanged() const = 0;
+
+		/**
+		 * Notifies this connected container that instances have been added to a multi binding of an ancestor.
+		 * Implementers merge their multi bindings again on the next lookup and pass the notification on to their children.
+		 */
+		virtual void NotifyMultiInstancesBound() const = 0;
+
 		/**
 		 * Requests this container to reevaluate all pending bindings in case they have become available through adding a parent container.
 		 * After this operation the container and its children should not have any more pending waits for already bound bindings.
@@ -69,9 +119,61 @@ namespace DI
 
 		/**
 		 * Try to find a binding in this container.
-		 * @param BindingId - the binding to look for
+		 * @param BindingKey - the binding to look for
 		 * @return the binding if it has been found, nullptr otherwise.
 		 */
-		virtual TSharedPtr<DI::FBinding> FindConnectedBinding(const DI::FBindingId& BindingId) const = 0;
+		virtual TSharedPtr<DI::FBinding> FindConnectedBinding(const DI::FBindingKey& BindingKey) const = 0;
+
+		/**
+		 * Same as FindConnectedBinding but without touching any reference counts.
+		 * @see FDiContainerBase::FindBorrowedBinding
+		 */
+		virtual DI::FBinding* FindConnectedBorrowedBinding(const DI::FBindingKey& BindingKey) const = 0;
+
+		/**
+		 * Same as FindConnectedBorrowedBinding but for all keys that do not have a binding in OutBindings yet.
+		 * @see FDiContainerBase::FindBorrowedBindings
+		 */
+		virtual void FindConnectedBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const = 0;
+
+		/**
+		 * Find the instances that this container and all of its ancestors hold for a multi binding key.
+		 * @return the merged multi binding or nullptr if nothing is bound for the key.
+		 * @see CMultiBindingProvider
+		 */
+		virtual const DI::FMultiBinding* FindConnectedMultiBinding(const DI::FBindingKey& BindingKey) const = 0;
+
+		/**
+		 * @return a filter that contains at least all keys that are bound in this container and all of its ancestors.
+		 * Implementers add keys in NotifyInstanceBound. In RetryAllPendingWaits and once the filter is overloaded,
+		 * they size it for their own keys and those of their parents and fill it again.
+		 */
+		virtual const FBindingKeyFilter& GetBindingFilter() const = 0;
+
+	protected:
+		/**
+		 * Groups all connected lookups in its scope into a single lookup.
+		 * Containers that are reachable through several paths (e.g. the world container through both parents of a forking container)
+		 * remember that they missed in the current lookup and are not searched again.
+		 * Nested scopes join the outermost one.
+		 */
+		class TENTACLE_API FLookupScope
+		{
+		public:
+			FLookupScope();
+			~FLookupScope();
+
+		private:
+			uint64 PreviousLookupId;
+		};
+
+		/** @return true if this container has already been searched without success in the current lookup scope. */
+		bool HasMissedInCurrentLookup() const;
+
+		/** Remember that this container has nothing to offer for the current lookup scope. */
+		void MarkMissedInCurrentLookup() const;
+
+	private:
+		mutable uint64 LastMissedLookupId = 0;
 	};
 }
@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include "BindConflictBehavior.h"
+#include "BindResult.h"
 #include "BindingSubscriptionList.h"
 #include "Binding.h"
+#include "MultiBinding.h"
 #include "Templates/Models.h"
 
 namespace DI
@@ -22,8 +25,8 @@ namespace DI
 	{
 		template <class TDiContainer>
 		auto Requires(TDiContainer& DiContainer,
-		              const FBindingId& BindingId) -> decltype(
-			DiContainer.FindBinding(BindingId)
+		              const FBindingKey& BindingKey) -> decltype(
+			DiContainer.FindBinding(BindingKey)
 		);
 	};
 
@@ -31,8 +34,8 @@ namespace DI
 	{
 		template <class TDiContainer>
 		auto Requires(const TDiContainer& DiContainer,
-		              const FBindingId& BindingId) -> decltype(
-			DiContainer.Subscribe(BindingId)
+		              const FBindingKey& BindingKey) -> decltype(
+			DiContainer.Subscribe(BindingKey)
 		);
 	};
 
@@ -63,7 +66,83 @@ namespace DI
 	concept DiContainerConcept = requires(T DiContainer)
 	{
 		{ DiContainer.BindSpecific(DeclVal<TSharedRef<DI::FBinding>>(), DeclVal<EBindConflictBehavior>()) } -> Private::convertible_to<EBindResult>;
-		{ DiContainer.FindBinding(DeclVal<const FBindingId&>()) } -> Private::convertible_to<TSharedPtr<DI::FBinding>>;
-		{ DiContainer.Subscribe(DeclVal<const FBindingId&>()) } -> Private::convertible_to<FBindingSubscriptionList::FOnInstanceBound&>;
+		{ DiContainer.FindBinding(DeclVal<const FBindingKey&>()) } -> Private::convertible_to<TSharedPtr<DI::FBinding>>;
+		{ DiContainer.Subscribe(DeclVal<const FBindingKey&>()) } -> Private::convertible_to<FBindingSubscriptionList::FOnInstanceBound&>;
+	};
+
+	/**
+	 * Optional extension of DiContainerConcept.
+	 * Containers that know the binding for T at compile time expose it through FindStaticBinding<T>() so resolving does not need a lookup.
+	 */
+	template <class TDiContainer, class T>
+	concept CStaticBindingProvider = requires(const TDiContainer& DiContainer)
+	{
+		{ DiContainer.template FindStaticBinding<T>() } -> Private::convertible_to<const TBindingType<T>*>;
+	};
+
+	/**
+	 * Optional extension of DiContainerConcept.
+	 * Containers that can hand out bindings without reference counting. The binding is only valid until the container is modified.
+	 */
+	template <class TDiContainer>
+	concept CBorrowedBindingProvider = requires(const TDiContainer& DiContainer, const FBindingKey& BindingKey)
+	{
+		{ DiContainer.FindBorrowedBinding(BindingKey) } -> Private::convertible_to<DI::FBinding*>;
+	};
+
+	/**
+	 * Optional extension of CBorrowedBindingProvider.
+	 * Containers that can look up several keys at once, so resolving many bindings only walks the container chain once.
+	 * Entries of OutBindings that are already set are skipped.
+	 */
+	template <class TDiContainer>
+	concept CBatchBindingProvider = requires(const TDiContainer& DiContainer, TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings)
+	{
+		DiContainer.FindBorrowedBindings(BindingKeys, OutBindings);
+	};
+
+	/**
+	 * Optional extension of DiContainerConcept.
+	 * Closed containers can only ever resolve the types for which they are a CStaticBindingProvider.
+	 */
+	template <class TDiContainer>
+	concept CClosedDiContainer = requires
+	{
+		requires !TDiContainer::bResolvesUndeclaredBindings;
+	};
+
+	/**
+	 * Optional extension of DiContainerConcept.
+	 * Containers that want to construct the bindings themselves instead of receiving a heap allocated binding through BindSpecific.
+	 */
+	template <class TDiContainer, class T>
+	concept CBindingEmplacer = requires(TDiContainer& DiContainer, const FBindingId& BindingId, TBindingInstRef<T> Instance, EBindConflictBehavior ConflictBehavior)
+	{
+		{ DiContainer.template EmplaceBinding<T>(BindingId, Instance, ConflictBehavior) } -> Private::convertible_to<EBindResult>;
+	};
+
+	/**
+	 * Optional extension of DiContainerConcept.
+	 * Containers that can tell whether a binding would be bound without constructing it.
+	 * Only the bindings of the container itself are checked, since it may shadow the bindings of its ancestors.
+	 */
+	template <class TDiContainer>
+	concept CBindingChecker = requires(const TDiContainer& DiContainer, const FBindingKey& BindingKey, EBindConflictBehavior ConflictBehavior)
+	{
+		{ DiContainer.CanBind(BindingKey, ConflictBehavior) } -> Private::convertible_to<EBindResult>;
+	};
+
+	/**
+	 * Optional extension of DiContainerConcept.
+	 * Containers that can hold any number of instances for a key next to the single binding of the key.
+	 * The multi binding that FindMultiBinding returns contains the instances of the container and all of its ancestors
+	 * and is only valid until anything is bound or the container graph changes.
+	 */
+	template <class TDiContainer>
+	concept CMultiBindingProvider = requires(TDiContainer& DiContainer, TSharedRef<FMultiBinding> MultiBinding, const FBindingKey& BindingKey,
+	                                         EBindConflictBehavior ConflictBehavior)
+	{
+		{ DiContainer.BindMulti(MultiBinding, ConflictBehavior) } -> Private::convertible_to<EBindResult>;
+		{ static_cast<const TDiContainer&>(DiContainer).FindMultiBinding(BindingKey) } -> Private::convertible_to<const FMultiBinding*>;
 	};
 }
@@ -0,0 +1,112 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Binding.h"
+#include "BindingKey.h"
+#include "DiContainerBase.h"
+
+namespace DI
+{
+	/**
+	 * Handle to a dependency that can be kept around instead of resolving it over and over again.
+	 * The binding is resolved on first use and cached until FDiContainerBase::GetResolveGeneration of the container changes,
+	 * so steady state access is a generation compare and a validity check. Rebinds, new parents and unbinds are followed.
+	 * Only binds into the container, its ancestors and changes to their parents make the handle resolve again.
+	 *
+	 * The handle does not keep anything alive and holds no UObject references, so it can be a plain member of UObjects and native classes.
+	 * Only use it on the game thread.
+	 * @code
+	 * DI::TDiRef<USimpleUService> SimpleService = DiContainer->Resolve().Ref<USimpleUService>();
+	 * if (SimpleService)
+	 * {
+	 *     SimpleService->DoSomething();
+	 * }
+	 * @endcode
+	 */
+	template <class T>
+	class TDiRef
+	{
+	public:
+		TDiRef() = default;
+
+		TDiRef(TSharedRef<const FDiContainerBase> InDiContainer, const FBindingKey& InBindingKey)
+			: DiContainer(InDiContainer), BorrowedDiContainer(&InDiContainer.Get()), BindingKey(InBindingKey)
+		{
+		}
+
+		/** @return the currently bound instance or an empty pointer if there is none. */
+		TBindingInstPtr<T> Get() const
+		{
+			if (const FBinding* Binding = FindBinding())
+			{
+				if (UNLIKELY(Binding->IsResolvedByFactory()))
+				{
+					// Factories run user code that can rebind or destroy containers, so keep the binding and the container alive while it runs.
+					const TSharedPtr<const FDiContainerBase> PinnedDiContainer = DiContainer.Pin();
+					const TSharedPtr<FBinding> PinnedBinding = PinnedDiContainer->FindBinding(BindingKey);
+					checkSlow(PinnedBinding.Get() == Binding);
+					return StaticCastSharedPtr<TBindingType<T>>(PinnedBinding)->Resolve();
+				}
+				return static_cast<const TBindingType<T>*>(Binding)->Resolve();
+			}
+			return {};
+		}
+
+		/** @return true if there currently is a binding. */
+		bool IsBound() const
+		{
+			return FindBinding() != nullptr;
+		}
+
+		explicit operator bool() const
+		{
+			return IsBound();
+		}
+
+		/** Access the instance. Check IsBound first if the binding might be missing. */
+		TBindingInstPtr<T> operator->() const
+		{
+			return Get();
+		}
+
+		const FBindingKey& GetBindingKey() const
+		{
+			return BindingKey;
+		}
+
+	private:
+		const FBinding* FindBinding() const
+		{
+			// IsValid only reads the reference count while Pin would have to increment and decrement it.
+			if (!DiContainer.IsValid())
+			{
+				return nullptr;
+			}
+
+			const uint64 ResolveGeneration = BorrowedDiContainer->GetResolveGeneration();
+			if (CachedGeneration == ResolveGeneration && (!CachedBinding || CachedBinding->IsValid()))
+			{
+				return CachedBinding;
+			}
+
+			// A binding that became invalid can be shadowing a valid binding in an ancestor, so look it up again.
+			CachedBinding = BorrowedDiContainer->FindBorrowedBinding(BindingKey);
+			CachedGeneration = ResolveGeneration;
+			return CachedBinding;
+		}
+
+		TWeakPtr<const FDiContainerBase> DiContainer;
+
+		// Raw alias of DiContainer so lookups can skip pinning. Only dereferenced while DiContainer is valid.
+		const FDiContainerBase* BorrowedDiContainer = nullptr;
+
+		FBindingKey BindingKey;
+
+		mutable const FBinding* CachedBinding = nullptr;
+
+		// Container generations start at 0, so a new handle always resolves on first use.
+		mutable uint64 CachedGeneration = MAX_uint64;
+	};
+}
@@ -25,7 +25,7 @@ namespace DI
 		// Technically, we could have a copy constructor, but copying is usually a user error, so we delete it to catch these cases earlier.
 		FForkingDiContainer(const FForkingDiContainer&) = delete;
 
-		virtual ~FForkingDiContainer() override = default;
+		virtual ~FForkingDiContainer() override;
 
 		/**
 		 * Add a parent to the chain.
@@ -45,15 +45,61 @@ namespace DI
 		virtual bool TryConnectSubcontainer(TSharedRef<FConnectedDiContainer> ConnectedDiContainer) override;
 		virtual bool TryDisconnectSubcontainer(TSharedRef<FConnectedDiContainer> ConnectedDiContainer) override;
 		virtual void NotifyInstanceBound(const DI::FBinding& NewBinding) const override;
+		virtual void NotifyGraphChanged() const override;
+		virtual void NotifyMultiInstancesBound() const override;
 		virtual void RetryAllPendingWaits() const override;
-		virtual TSharedPtr<DI::FBinding> FindConnectedBinding(const DI::FBindingId& BindingId) const override;
+		virtual TSharedPtr<DI::FBinding> FindConnectedBinding(const DI::FBindingKey& BindingKey) const override;
+		virtual DI::FBinding* FindConnectedBorrowedBinding(const DI::FBindingKey& BindingKey) const override;
+		virtual void FindConnectedBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const override;
+		virtual const DI::FMultiBinding* FindConnectedMultiBinding(const DI::FBindingKey& BindingKey) const override;
+		virtual const FBindingKeyFilter& GetBindingFilter() const override;
 		// --
 
+		/** @return the binding of the highest priority parent that has one. Answers repeated lookups from WinnerCache. */
+		const TSharedPtr<DI::FBinding>* FindWinningBinding(const DI::FBindingKey& BindingKey) const;
+
+		/** Drops the WinnerCache if the graph or any binding changed since it was filled. */
+		void RefreshWinnerCache() const;
+
+		struct FParentContainer
+		{
+			int32 Priority;
+			TWeakPtr<FConnectedDiContainer> Container;
+			// Raw alias of Container so borrowed lookups can skip pinning. Only dereferenced while Container is valid.
+			FConnectedDiContainer* BorrowedContainer;
+		};
+
 		/**
 		 * Higher priority containers will be checked first.
 		 * mutable so we can use clear up dead parents in const methods
 		 */
-		mutable TArray<TPair<int32, TWeakPtr<FConnectedDiContainer>>, TInlineAllocator<4>> ParentContainers;
+		mutable TArray<FParentContainer, TInlineAllocator<4>> ParentContainers;
+
+		/** Keys bound in any of the ancestors. */
+		mutable FBindingKeyFilter BindingFilter;
+
+		/** Size the BindingFilter for the keys of all ancestors and fill it again. */
+		void RebuildBindingFilter() const;
+
+		/** Bindings of the winning parents. Only valid while the generations below match. */
+		mutable TBindingIndex<TSharedPtr<DI::FBinding>> WinnerCache;
+		mutable uint32 WinnerCacheGraphGeneration = 0;
+		mutable uint32 WinnerCacheBindGeneration = 0;
+
+		/**
+		 * Multi bindings of all parents merged in priority order. Entries are merged again once the resolve generation changed.
+		 * Instances of ancestors that are reachable through several parents are only merged in once.
+		 */
+		mutable TBindingIndex<FMergedMultiBinding> MergedMultiBindings;
+
+		/** Bumped for every binding that is bound in any of the ancestors. */
+		mutable uint32 BindGeneration = 0;
+
+		/** Bumped whenever the parents of this container or any of its ancestors change, or an ancestor is destroyed. */
+		mutable uint32 GraphGeneration = 0;
+
+		/** Bumped for every notification, so it changes whenever a lookup through this container might find something else. */
+		mutable uint64 ResolveGeneration = 0;
 
 		// Mutable so we can clean up invalid children in getters
 		mutable TArray<TWeakPtr<FConnectedDiContainer>, TInlineAllocator<1>> ChildrenContainers;
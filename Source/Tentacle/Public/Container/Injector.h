@@ -647,7 +647,9 @@ namespace DI
 		template <class... TArgumentTypes>
 		auto TryGetFromArgumentTypes(EResolveErrorBehavior ErrorBehavior) const
 		{
-			return this->template TryGetFromArgumentsNamed<TArgumentTypes...>(ErrorBehavior, (TVoid<TArgumentTypes>(), NAME_None)...);
+			// Unnamed arguments reuse the binding keys that are built once per argument list.
+			auto ResolvedPointers = DiContainer.Resolve().template TryGetMany<typename TBindingInstBaseType<TArgumentTypes>::Type...>(ErrorBehavior);
+			return TryDerefAllInstances(ResolvedPointers);
 		}
 
 		template <class TTupleWithArgsType>
@@ -663,9 +665,10 @@ namespace DI
 				return Injector.TryGetFromArgumentTypes<TTupleWithArgsTypes...>(ErrorBehavior);
 			}
 
-			static TOptional<TTuple<TTupleWithArgsTypes...>> ResolveNamed(const TInjector& Injector, EResolveErrorBehavior ErrorBehavior, FName BindingNames...)
+			template <class... TNames>
+			static TOptional<TTuple<TTupleWithArgsTypes...>> ResolveNamed(const TInjector& Injector, EResolveErrorBehavior ErrorBehavior, TNames... BindingNames)
 			{
-				return Injector.TryGetFromArgumentsNamed<TTupleWithArgsTypes...>(ErrorBehavior, BindingNames);
+				return Injector.template TryGetFromArgumentsNamed<TTupleWithArgsTypes...>(ErrorBehavior, BindingNames...);
 			}
 		};
 
@@ -684,7 +687,7 @@ namespace DI
 		template <class... TArgumentTypes, class... TNames>
 		auto TryGetFromArgumentsNamed(EResolveErrorBehavior ErrorBehavior, TNames... Names) const
 		{
-			auto ResolvedPointers = MakeTuple(DiContainer.Resolve().template TryGetNamed<typename TBindingInstBaseType<TArgumentTypes>::Type>(Names, ErrorBehavior)...);
+			auto ResolvedPointers = DiContainer.Resolve().template TryGetManyNamed<typename TBindingInstBaseType<TArgumentTypes>::Type...>(ErrorBehavior, Names...);
 			return TryDerefAllInstances(ResolvedPointers);
 		}
 
@@ -0,0 +1,196 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TentacleTemplates.h"
+#include "UObject/GCObject.h"
+#include "UObject/Package.h"
+
+namespace DI
+{
+	/**
+	 * Pool of native instances for transient bindings.
+	 * Instances are handed out as shared references that put the instance back into the pool when the last reference is released
+	 * instead of deleting it.
+	 * @note Releasing is thread safe, so references may be dropped on any thread. Instances are acquired on the resolving thread.
+	 */
+	template <class T>
+	class TNativeInstancePool : public TSharedFromThis<TNativeInstancePool<T>>
+	{
+	public:
+		static constexpr int32 DefaultMaxFree = 64;
+
+		/**
+		 * @param InResetInstance - (Optional) called on pooled instances before they are handed out again.
+		 * @param InMaxFree - maximum number of instances kept for reuse. Instances released beyond that are deleted.
+		 */
+		explicit TNativeInstancePool(TFunction<void(T&)> InResetInstance = nullptr, int32 InMaxFree = DefaultMaxFree)
+			: ResetInstance(MoveTemp(InResetInstance)), MaxFree(InMaxFree)
+		{
+		}
+
+		TNativeInstancePool(const TNativeInstancePool&) = delete;
+		TNativeInstancePool& operator=(const TNativeInstancePool&) = delete;
+
+		~TNativeInstancePool()
+		{
+			for (T* FreeInstance : FreeInstances)
+			{
+				delete FreeInstance;
+			}
+		}
+
+		/** @return a pooled instance or a new one if the pool is empty. */
+		TSharedRef<T> Acquire()
+		{
+			T* Instance = nullptr;
+			{
+				FScopeLock Lock(&FreeInstancesLock);
+				if (!FreeInstances.IsEmpty())
+				{
+					Instance = FreeInstances.Pop(EAllowShrinking::No);
+				}
+			}
+
+			if (Instance)
+			{
+				if (ResetInstance)
+				{
+					ResetInstance(*Instance);
+				}
+			}
+			else
+			{
+				Instance = new T();
+			}
+
+			// Instances that are released after the pool has been destroyed are deleted as usual.
+			return MakeShareable(Instance, [WeakPool = this->AsWeak()](T* ReleasedInstance)
+			{
+				if (TSharedPtr<TNativeInstancePool> Pool = WeakPool.Pin())
+				{
+					Pool->Release(ReleasedInstance);
+				}
+				else
+				{
+					delete ReleasedInstance;
+				}
+			});
+		}
+
+		/** @return the number of instances that are ready for reuse. */
+		int32 NumFree() const
+		{
+			FScopeLock Lock(&FreeInstancesLock);
+			return FreeInstances.Num();
+		}
+
+	private:
+		void Release(T* Instance)
+		{
+			{
+				FScopeLock Lock(&FreeInstancesLock);
+				if (FreeInstances.Num() < MaxFree)
+				{
+					FreeInstances.Push(Instance);
+					return;
+				}
+			}
+			delete Instance;
+		}
+
+		TFunction<void(T&)> ResetInstance;
+		int32 MaxFree;
+		mutable FCriticalSection FreeInstancesLock;
+		TArray<T*> FreeInstances;
+	};
+
+	/**
+	 * Pool of UObject instances for transient bindings.
+	 * The garbage collector can not hand objects back, so instances have to be returned explicitly with Release once they are no longer used.
+	 * Instances that are never released are collected as usual.
+	 * @note Only use on the game thread.
+	 */
+	template <class T>
+	class TObjectInstancePool : public FGCObject
+	{
+	public:
+		static constexpr int32 DefaultMaxFree = 64;
+
+		/**
+		 * @param InResetInstance - (Optional) called on pooled instances before they are handed out again.
+		 * @param InMaxFree - maximum number of instances kept for reuse. Instances released beyond that are left to the garbage collector.
+		 * @param InOuter - (Optional) outer of new instances. Defaults to the transient package.
+		 */
+		explicit TObjectInstancePool(TFunction<void(T&)> InResetInstance = nullptr, int32 InMaxFree = DefaultMaxFree, UObject* InOuter = nullptr)
+			: ResetInstance(MoveTemp(InResetInstance)), MaxFree(InMaxFree), Outer(InOuter)
+		{
+		}
+
+		/** @return a pooled instance or a new one if the pool is empty. */
+		TObjectPtr<T> Acquire()
+		{
+			while (!FreeInstances.IsEmpty())
+			{
+				TObjectPtr<T> Instance = FreeInstances.Pop(EAllowShrinking::No);
+				if (IsValid(Instance))
+				{
+					if (ResetInstance)
+					{
+						ResetInstance(*Instance);
+					}
+					return Instance;
+				}
+			}
+			return NewObject<T>(Outer ? Outer.Get() : GetTransientPackage());
+		}
+
+		/** Put an instance back into the pool. It must not be used by the caller afterward. */
+		void Release(TObjectPtr<T> Instance)
+		{
+			if (IsValid(Instance) && FreeInstances.Num() < MaxFree)
+			{
+				checkSlow(!FreeInstances.Contains(Instance));
+				FreeInstances.Push(MoveTemp(Instance));
+			}
+		}
+
+		/** @return the number of instances that are ready for reuse. */
+		int32 NumFree() const
+		{
+			return FreeInstances.Num();
+		}
+
+		// - FGCObject
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			Collector.AddReferencedObjects(FreeInstances);
+			Collector.AddReferencedObject(Outer);
+		}
+
+		virtual FString GetReferencerName() const override
+		{
+			return TEXT("DI::TObjectInstancePool");
+		}
+		// --
+
+	private:
+		TFunction<void(T&)> ResetInstance;
+		int32 MaxFree;
+		TObjectPtr<UObject> Outer;
+		TArray<TObjectPtr<T>> FreeInstances;
+	};
+
+	/**
+	 * The pool type that serves transient bindings of T.
+	 * Interfaces and UStructs can not be pooled.
+	 */
+	template <class T>
+	using TInstancePool = TBindingInstanceTypeSwitch<
+		T,
+		TObjectInstancePool<T>, // UObject
+		void, // IInterface
+		void, // UStruct
+		TNativeInstancePool<T>>; // Native
+}
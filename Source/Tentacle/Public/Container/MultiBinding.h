@@ -0,0 +1,180 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BindingKey.h"
+#include "TentacleTemplates.h"
+#include "UObject/Class.h"
+
+namespace DI
+{
+	/**
+	 * Any number of instances that are bound for the same key and stored next to each other.
+	 * Every container holds at most one multi binding per key and appends all instances bound for the key to it.
+	 *
+	 * Unlike FBinding this has a vtable. Only appending and garbage collection are virtual,
+	 * reading the instances goes through the typed array of TMultiBinding.
+	 */
+	class FMultiBinding
+	{
+	public:
+		explicit FMultiBinding(const FBindingKey& InKey)
+			: Key(InKey)
+		{
+		}
+
+		virtual ~FMultiBinding() = default;
+
+		FORCEINLINE const FBindingKey& GetKey() const
+		{
+			return Key;
+		}
+
+		/** @return a multi binding of the same type and key without any instances. */
+		virtual TSharedRef<FMultiBinding> MakeEmpty() const = 0;
+
+		/** Append all instances of Other, which has to have the same key. */
+		virtual void Append(const FMultiBinding& Other) = 0;
+
+		/** Append the instances of Other that are not contained yet. */
+		virtual void AppendUnique(const FMultiBinding& Other) = 0;
+
+		/** Remove all instances but keep the memory. */
+		virtual void Reset() = 0;
+
+		virtual int32 Num() const = 0;
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) = 0;
+
+	private:
+		FBindingKey Key;
+	};
+
+	template <class T>
+	class TMultiBinding final : public FMultiBinding
+	{
+		static_assert(!std::is_reference_v<TBindingInstRef<T>>, "UStructs can not be multi bound.");
+
+	public:
+		using Super = FMultiBinding;
+
+		explicit TMultiBinding(const FBindingKey& InKey)
+			: Super(InKey)
+		{
+		}
+
+		TMultiBinding(const FBindingKey& InKey, TBindingInstRef<T> Instance)
+			: Super(InKey)
+		{
+			Instances.Add(MoveTemp(Instance));
+		}
+
+		FORCEINLINE TConstArrayView<TBindingInstRef<T>> GetInstances() const
+		{
+			return Instances;
+		}
+
+		virtual TSharedRef<FMultiBinding> MakeEmpty() const override
+		{
+			return MakeShared<TMultiBinding>(GetKey());
+		}
+
+		virtual void Append(const FMultiBinding& Other) override
+		{
+			check(Other.GetKey() == GetKey());
+			Instances.Append(static_cast<const TMultiBinding&>(Other).Instances);
+		}
+
+		virtual void AppendUnique(const FMultiBinding& Other) override
+		{
+			check(Other.GetKey() == GetKey());
+			for (const TBindingInstRef<T>& Instance : static_cast<const TMultiBinding&>(Other).Instances)
+			{
+				if (!Instances.Contains(Instance))
+				{
+					Instances.Add(Instance);
+				}
+			}
+		}
+
+		virtual void Reset() override
+		{
+			Instances.Reset();
+		}
+
+		virtual int32 Num() const override
+		{
+			return Instances.Num();
+		}
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			if constexpr (TIsIInterface<T>::Value)
+			{
+				for (TBindingInstRef<T>& Instance : Instances)
+				{
+					Instance.AddReferencedObjects(Collector);
+				}
+			}
+			else if constexpr (THasUClass<T>::Value)
+			{
+				Collector.AddReferencedObjects(Instances);
+			}
+		}
+
+	private:
+		TArray<TBindingInstRef<T>> Instances;
+	};
+
+	/**
+	 * What a connected container found for a multi binding key, cached until the resolve generation changes.
+	 * The first multi binding that is found is referenced directly. Instances are only copied once a second one has to be merged in,
+	 * and the copy reuses the memory of the previous merge, so looking up the same key again does not allocate.
+	 */
+	struct FMergedMultiBinding
+	{
+		/** The multi binding to hand out. Points either to Storage or to the multi binding of a container. */
+		const FMultiBinding* Result = nullptr;
+		TSharedPtr<FMultiBinding> Storage;
+		uint64 ResolveGeneration = MAX_uint64;
+
+		/** Drop the previous result before merging for ResolveGeneration. */
+		void Begin(uint64 InResolveGeneration)
+		{
+			Result = nullptr;
+			ResolveGeneration = InResolveGeneration;
+		}
+
+		/**
+		 * Merge the instances of MultiBinding in after the ones that have been merged so far.
+		 * @param bUnique - skip instances that are already contained, e.g. because they have been reached through another parent.
+		 */
+		void Merge(const FMultiBinding& MultiBinding, bool bUnique)
+		{
+			if (!Result)
+			{
+				Result = &MultiBinding;
+				return;
+			}
+			if (Result != Storage.Get())
+			{
+				if (!Storage.IsValid())
+				{
+					Storage = MultiBinding.MakeEmpty();
+				}
+				Storage->Reset();
+				Storage->Append(*Result);
+				Result = Storage.Get();
+			}
+			if (bUnique)
+			{
+				Storage->AppendUnique(MultiBinding);
+			}
+			else
+			{
+				Storage->Append(MultiBinding);
+			}
+		}
+	};
+}
@@ -7,6 +7,7 @@
 namespace DI
 {
 	class FBindingId;
+	class FBindingKey;
 
 	enum class EResolveErrorBehavior
 	{
@@ -27,4 +28,7 @@ namespace DI
 	constexpr EResolveErrorBehavior GDefaultResolveErrorBehavior = EResolveErrorBehavior::LogError;
 
 	TENTACLE_API void HandleResolveError(const FBindingId& BindingId, EResolveErrorBehavior ErrorBehavior);
+
+	/** Overload for the hot path. The key is only turned back into an id if the error is actually reported. */
+	TENTACLE_API void HandleResolveError(const FBindingKey& BindingKey, EResolveErrorBehavior ErrorBehavior);
 }
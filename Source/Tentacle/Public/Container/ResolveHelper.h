@@ -4,14 +4,35 @@
 
 #include "CoreMinimal.h"
 #include "Container/Binding.h"
+#include "Container/BindingName.h"
+#include "Container/DiRef.h"
+#include "Container/StructBindingView.h"
 #include "WeakFuture.h"
 #include "DiContainerConcept.h"
 #include "ResolveErrorBehavior.h"
 #include "Tentacle.h"
+#include "TentacleTemplates.h"
 #include "Blueprint/BlueprintExceptionInfo.h"
 
 namespace DI
 {
+	namespace Private
+	{
+		/**
+		 * Binding keys of the unnamed bindings of Ts.
+		 * Built once per type list, so resolving or injecting into the same argument list again reuses them.
+		 */
+		template <class... Ts>
+		struct TResolvePlan
+		{
+			static TConstArrayView<FBindingKey> GetBindingKeys()
+			{
+				static const FBindingKey BindingKeys[] = {MakeBindingKey<Ts>()...};
+				return BindingKeys;
+			}
+		};
+	}
+
 	/**
 	 * DiContainer agnostic implementation of common resolving operations.
 	 * This helps in keeping the number of functions to be implemented for a DiContainer type to be very minimal
@@ -38,8 +59,15 @@ namespace DI
 			FName BindingName,
 			EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
 		{
-			FBindingId BindingId = FBindingId(FTypeId(ObjectType), BindingName);
-			return this->Get<UObject>(BindingId, ErrorBehavior);
+			const FBindingKey BindingKey = FBindingKey(FBindingId(FTypeId(ObjectType), BindingName));
+			// The binding may have been created for any subclass of UObject, so it has to be resolved without assuming its type.
+			if (TSharedPtr<DI::FBinding> BindingInstance = DiContainer.FindBinding(BindingKey))
+			{
+				checkSlow(BindingInstance->GetKind() == EBindingKind::UObject);
+				return StaticCastSharedPtr<const DI::FUObjectBinding>(BindingInstance)->ResolveUntyped();
+			}
+			HandleResolveError(BindingKey, ErrorBehavior);
+			return {};
 		}
 
 		/**
@@ -56,24 +84,76 @@ namespace DI
 			FName BindingName,
 			EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
 		{
-			FBindingId BindingId = FBindingId(FTypeId(StructType), BindingName);
+			const FBindingKey BindingKey = FBindingKey(FBindingId(FTypeId(StructType), BindingName));
 
 			static_assert(
 				TIsDerivedFrom<TBindingType<FHitResult>, DI::FRawDataBinding>::IsDerived,
 				"This code assumes that UStruct bindings inherit from FRawDataBinding"
 			);
-			if (TSharedPtr<DI::FRawDataBinding> BindingInstance = StaticCastSharedPtr<DI::FRawDataBinding>(DiContainer.FindBinding(BindingId)))
+			if constexpr (CBorrowedBindingProvider<TDiContainer>)
 			{
-				BindingInstance->CopyRawData(OutStructMemory, StructType->GetStructureSize());
-				return true;
+				if (DI::FBinding* BindingInstance = DiContainer.FindBorrowedBinding(BindingKey))
+				{
+					static_cast<DI::FRawDataBinding*>(BindingInstance)->CopyRawData(OutStructMemory, StructType->GetStructureSize());
+					return true;
+				}
 			}
-			else
+			else if (TSharedPtr<DI::FRawDataBinding> BindingInstance = StaticCastSharedPtr<DI::FRawDataBinding>(DiContainer.FindBinding(BindingKey)))
 			{
-				HandleResolveError(BindingId, ErrorBehavior);
+				BindingInstance->CopyRawData(OutStructMemory, StructType->GetStructureSize());
+				return true;
 			}
+			HandleResolveError(BindingKey, ErrorBehavior);
 			return false;
 		}
 
+		/**
+		 * Get read only access to the data of a UStruct binding without copying it.
+		 * Prefer this over TryGetUStruct for large structs that are read often.
+		 * @param StructType - struct class of the UStruct.
+		 * @param BindingName - (Optional) Name of the struct binding
+		 * @param ErrorBehavior - specified what to do if the binding is not found.
+		 * @return a view that keeps the binding alive or an empty view if the binding was not found.
+		 */
+		FStructBindingView TryGetUStructView(
+			const UScriptStruct* StructType,
+			FName BindingName,
+			EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
+		{
+			const FBindingKey BindingKey = FBindingKey(FBindingId(FTypeId(StructType), BindingName));
+			return this->GetStructView(BindingKey, ErrorBehavior);
+		}
+
+		/**
+		 * Get read only access to the data of a UStruct binding without copying it.
+		 * @code
+		 * DI::FStructBindingView TuningView = DiContainer.Resolve().TryGetStructView<FTuningTable>();
+		 * @endcode
+		 * @tparam T type of the struct binding that it was bound with.
+		 * @param ErrorBehavior - specified what to do if the binding is not found.
+		 * @return a view that keeps the binding alive or an empty view if the binding was not found.
+		 */
+		template <class T>
+		FStructBindingView TryGetStructView(EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
+		{
+			static_assert(TModels<CStaticStructProvider, T>::Value, "Only UStructs can be viewed.");
+			return this->GetStructView(MakeBindingKey<T>(), ErrorBehavior);
+		}
+
+		/**
+		 * Get read only access to the data of a named UStruct binding without copying it.
+		 * @tparam T type of the struct binding that it was bound with.
+		 * @param BindingName - Name of the binding. Either a FName or a TBindingName.
+		 * @param ErrorBehavior - specified what to do if the binding is not found.
+		 * @return a view that keeps the binding alive or an empty view if the binding was not found.
+		 */
+		template <class T, class TName>
+		FStructBindingView TryGetStructViewNamed(const TName& BindingName, EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
+		{
+			static_assert(TModels<CStaticStructProvider, T>::Value, "Only UStructs can be viewed.");
+			return this->GetStructView(MakeBindingKey<T>(BindingName), ErrorBehavior);
+		}
+
 		/**
 		 * Try to resolve a single instance by type.
 		 * @code
@@ -86,8 +166,7 @@ namespace DI
 		template <class T>
 		DI::TBindingInstPtr<T> TryGet(EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
 		{
-			FBindingId BindingId = MakeBindingId<T>();
-			return this->Get<T>(BindingId, ErrorBehavior);
+			return this->Get<T>(MakeBindingKey<T>(), ErrorBehavior);
 		}
 
 		/**
@@ -102,7 +181,40 @@ namespace DI
 		template <class... Ts>
 		TTuple<DI::TBindingInstPtr<Ts>...> TryGetMany(EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
 		{
-			return MakeTuple(this->Get<Ts>(MakeBindingId<Ts>(), ErrorBehavior)...);
+			if constexpr (sizeof...(Ts) == 0)
+			{
+				return MakeTuple();
+			}
+			else
+			{
+				return this->template GetMany<Ts...>(Private::TResolvePlan<Ts...>::GetBindingKeys(), ErrorBehavior, std::index_sequence_for<Ts...>());
+			}
+		}
+
+		/**
+		 * Try to resolve multiple instances based on their type and name.
+		 * All bindings are looked up in a single walk over the container chain.
+		 * @code
+		 * auto [ResolvedUService, ResolvedUInterface] = DiContainer.Resolve().TryGetManyNamed<USimpleUService, ISimpleInterface>(DI::EResolveErrorBehavior::LogWarning, "SomeName", NAME_None);
+		 * @endcode
+		 * @tparam Ts - Types of the bindings that they were bound with. Only exact class matches can be resolved.
+		 * @param ErrorBehavior - specified what to do if any of the bindings are not found.
+		 * @param BindingNames - Names of the bindings in the same order as the types.
+		 * @return The bindings in the same order as the types. Failed lookups will have null values.
+		 */
+		template <class... Ts, class... TNames>
+		TTuple<DI::TBindingInstPtr<Ts>...> TryGetManyNamed(EResolveErrorBehavior ErrorBehavior, const TNames&... BindingNames) const
+		{
+			static_assert(sizeof...(Ts) == sizeof...(TNames), "There has to be one binding name for every type.");
+			if constexpr (sizeof...(Ts) == 0)
+			{
+				return MakeTuple();
+			}
+			else
+			{
+				const FBindingKey BindingKeys[] = {MakeBindingKey<Ts>(BindingNames)...};
+				return this->template GetMany<Ts...>(BindingKeys, ErrorBehavior, std::index_sequence_for<Ts...>());
+			}
 		}
 
 		/**
@@ -111,14 +223,73 @@ namespace DI
 		 * DiContainer.Resolve().TryGetNamed<USimpleUService>("SomeName", DI::EResolveErrorBehavior::ReturnNull)
 		 * @endcode
 		 * @tparam T - Type of the binding that it was bound with. Only exact class matches can be resolved.
+		 * @param BindingName - Name of the binding. Either an FName or a TBindingName, which skips creating the FName and binding key.
 		 * @param ErrorBehavior - specified what to do if the binding is not found.
 		 * @return The bindings in the same order as the types. Failed lookups will have null values.
 		 */
+		template <class T, class TName>
+		DI::TBindingInstPtr<T> TryGetNamed(const TName& BindingName, EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
+		{
+			return this->Get<T>(MakeBindingKey<T>(BindingName), ErrorBehavior);
+		}
+
+		/**
+		 * Resolve all instances that are bound for T with MultiInstance in this container and all of its ancestors.
+		 * Instances of the container come first, followed by those of its parents in priority order.
+		 * The merged instances are cached, so resolving them again does not allocate until anything is bound or the container graph changes.
+		 * @code
+		 * for (const TObjectPtr<UDamageModifier>& DamageModifier : DiContainer.Resolve().All<UDamageModifier>())
+		 * {
+		 *     Damage = DamageModifier->Modify(Damage);
+		 * }
+		 * @endcode
+		 * @tparam T - Type of the bindings that they were bound with. Only exact class matches can be resolved.
+		 * @return A view of the instances. Only valid until anything is bound or the container graph changes, so do not keep it.
+		 * Instances of UObjects that have been destroyed explicitly may be null.
+		 */
+		template <class T>
+		TConstArrayView<DI::TBindingInstRef<T>> All() const
+		{
+			return this->GetAll<T>(MakeBindingKey<T>());
+		}
+
+		/**
+		 * Resolve all instances that are bound for T and the name with NamedMultiInstance.
+		 * @see All
+		 * @param BindingName - Name of the bindings. Either an FName or a TBindingName.
+		 */
+		template <class T, class TName>
+		TConstArrayView<DI::TBindingInstRef<T>> AllNamed(const TName& BindingName) const
+		{
+			return this->GetAll<T>(MakeBindingKey<T>(BindingName));
+		}
+
+		/**
+		 * Get a handle that resolves T when it is used and follows rebinds, so it can be kept instead of resolving every frame.
+		 * Only available for containers that are owned by a shared pointer, like FChainedDiContainer.
+		 * @code
+		 * DI::TDiRef<USimpleUService> SimpleService = DiContainer->Resolve().Ref<USimpleUService>();
+		 * @endcode
+		 * @tparam T - Type of the binding that it was bound with. Only exact class matches can be resolved.
+		 * @return A handle to the binding. The binding does not need to be bound yet.
+		 */
 		template <class T>
-		DI::TBindingInstPtr<T> TryGetNamed(const FName& BindingName, EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
+		TDiRef<T> Ref() const
+		{
+			return this->template RefNamed<T>(NAME_None);
+		}
+
+		/**
+		 * Get a handle that resolves the named binding of T when it is used and follows rebinds.
+		 * @see Ref
+		 * @param BindingName - Name of the binding. Either an FName or a TBindingName.
+		 */
+		template <class T, class TName>
+		TDiRef<T> RefNamed(const TName& BindingName) const
 		{
-			FBindingId BindingId = MakeBindingId<T>(BindingName);
-			return this->Get<T>(BindingId, ErrorBehavior);
+			static_assert(TIsDerivedFrom<TDiContainer, FDiContainerBase>::Value && TIsDerivedFrom<TDiContainer, TSharedFromThis<TDiContainer>>::Value,
+				"TDiRef needs a DI container that derives from FDiContainerBase and is owned by a shared pointer.");
+			return TDiRef<T>(DiContainer.AsShared(), MakeBindingKey<T>(BindingName));
 		}
 
 		template <class T>
@@ -184,7 +355,9 @@ namespace DI
 			UObject* WaitingObject = nullptr,
 			EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
 		{
-			return this->template WaitForManyNamed<Ts...>(WaitingObject, ErrorBehavior, (TVoid<Ts>(), NAME_None)...);
+			return this->template WaitForManyResolved<Ts...>(
+				this->template TryGetMany<Ts...>(EResolveErrorBehavior::ReturnNull),
+				WaitingObject, ErrorBehavior, std::index_sequence_for<Ts...>(), (TVoid<Ts>(), NAME_None)...);
 		}
 
 		/**
@@ -220,10 +393,10 @@ namespace DI
 		template <class... Ts, class... TNames>
 		TWeakFutureSet<TBindingInstRef<Ts>...> WaitForManyNamed(UObject* WaitingObject, EResolveErrorBehavior ErrorBehavior, TNames... BindingNames) const
 		{
-			TTuple<TWeakFuture<TBindingInstRef<Ts>>...> Futures = TTuple<TWeakFuture<TBindingInstRef<Ts>>...>(
-				this->template WaitForNamed<Ts>(BindingNames, WaitingObject, ErrorBehavior)...
-			);
-			return AwaitAllInTuple(MoveTemp(Futures));
+			// Usually most of the bindings are bound already. They are resolved in one batch and only the missing ones are waited for.
+			return this->template WaitForManyResolved<Ts...>(
+				this->template TryGetManyNamed<Ts...>(EResolveErrorBehavior::ReturnNull, BindingNames...),
+				WaitingObject, ErrorBehavior, std::index_sequence_for<Ts...>(), BindingNames...);
 		}
 
 		template <class... Ts, class... TNames>
@@ -246,26 +419,26 @@ namespace DI
 		 * @endcode
 		 *
 		 * @tparam TInstanceType - Type of the binding that it was bound with. Only exact class matches can be resolved.
-		 * @param BindingName - Name of the binding.
+		 * @param BindingName - Name of the binding. Either an FName or a TBindingName.
 		 * @param WaitingObject - (Optional) The UObject that is putting forward this request.
 		 * Used for printing debug logs and valid checking in case the requesting object is deleted before the bindings are resolved.
 		 * @param ErrorBehavior - specified what to do if the binding is not found.
 		 * @return A Weak Future that completes once the dependency is bound or the container is dropped.
 		 */
-		template <class TInstanceType>
+		template <class TInstanceType, class TName>
 		TWeakFuture<TBindingInstRef<TInstanceType>> WaitForNamed(
-			const FName& BindingName,
+			const TName& BindingName,
 			UObject* WaitingObject = nullptr,
 			EResolveErrorBehavior ErrorBehavior = GDefaultResolveErrorBehavior) const
 		{
-			FBindingId BindingId = MakeBindingId<TInstanceType>(BindingName);
+			const FBindingKey BindingKey = MakeBindingKey<TInstanceType>(BindingName);
 			auto [Promise, Future] = MakeWeakPromisePair<TBindingInstRef<TInstanceType>>();
-			TBindingInstPtr<TInstanceType> MaybeInstance = this->Get<TInstanceType>(BindingId, EResolveErrorBehavior::ReturnNull);
+			TBindingInstPtr<TInstanceType> MaybeInstance = this->Get<TInstanceType>(BindingKey, EResolveErrorBehavior::ReturnNull);
 			if (MaybeInstance)
 			{
 				Promise.EmplaceValue(ToRefType(MaybeInstance));
 			}
-			else
+			else if (!this->template RequestFactoryInstance<TInstanceType>(BindingKey, Promise))
 			{
 				auto Callback = [Promise = MoveTemp(Promise)](const DI::FBinding& BindingInstance) mutable
 				{
@@ -275,19 +448,19 @@ namespace DI
 				};
 				if (WaitingObject)
 				{
-					DiContainer.Subscribe(BindingId).AddWeakLambda(WaitingObject, Callback);
+					DiContainer.Subscribe(BindingKey).AddWeakLambda(WaitingObject, Callback);
 				}
 				else
 				{
-					DiContainer.Subscribe(BindingId).AddLambda(Callback);
+					DiContainer.Subscribe(BindingKey).AddLambda(Callback);
 				}
 			}
 			auto [NextPromise, NextFuture] = MakeWeakPromisePair<TBindingInstRef<TInstanceType>>();
-			Future.Then([BindingId, ErrorBehavior, NextPromise](TWeakFuture<TBindingInstRef<TInstanceType>> FutureInstance) mutable
+			Future.Then([BindingKey, ErrorBehavior, NextPromise](TWeakFuture<TBindingInstRef<TInstanceType>> FutureInstance) mutable
 			{
 				if (FutureInstance.WasCanceled())
 				{
-					HandleResolveError(BindingId, ErrorBehavior);
+					HandleResolveError(BindingKey, ErrorBehavior);
 					NextPromise.Cancel();
 					return;
 				}
@@ -298,16 +471,193 @@ namespace DI
 
 	private:
 		/**
-		 * Private so no one passes in a binding Id that does not match T
+		 * Private so no one passes in a binding key that does not match T
 		 */
 		template <class T>
-		DI::TBindingInstPtr<T> Get(const FBindingId& BindingId, EResolveErrorBehavior ErrorBehavior) const
+		DI::TBindingInstPtr<T> Get(const FBindingKey& BindingKey, EResolveErrorBehavior ErrorBehavior) const
 		{
-			if (TSharedPtr<DI::FBinding> BindingInstance = DiContainer.FindBinding(BindingId))
+			static_assert(!CClosedDiContainer<TDiContainer> || CStaticBindingProvider<TDiContainer, T>,
+				"The DI container can never provide this type. Add the type to the types of the static DI container.");
+			if constexpr (CStaticBindingProvider<TDiContainer, T>)
+			{
+				if (!BindingKey.IsNamed())
+				{
+					if (const TBindingType<T>* StaticBinding = DiContainer.template FindStaticBinding<T>())
+					{
+						return StaticBinding->Resolve();
+					}
+				}
+			}
+
+			if constexpr (CBorrowedBindingProvider<TDiContainer>)
+			{
+				return this->template ResolveBorrowed<T>(DiContainer.FindBorrowedBinding(BindingKey), BindingKey, ErrorBehavior);
+			}
+			else if (TSharedPtr<DI::FBinding> BindingInstance = DiContainer.FindBinding(BindingKey))
 			{
 				return StaticCastSharedPtr<DI::TBindingType<T>>(BindingInstance)->Resolve();
 			}
-			HandleResolveError(BindingId, ErrorBehavior);
+			HandleResolveError(BindingKey, ErrorBehavior);
+			return {};
+		}
+
+		/**
+		 * Private so no one passes in a binding key that does not belong to a UStruct.
+		 * Uses FindBinding instead of borrowing, because the view has to keep the binding alive.
+		 */
+		FStructBindingView GetStructView(const FBindingKey& BindingKey, EResolveErrorBehavior ErrorBehavior) const
+		{
+			if (TSharedPtr<DI::FBinding> BindingInstance = DiContainer.FindBinding(BindingKey))
+			{
+				checkSlow(BindingInstance->GetKind() == EBindingKind::UStruct);
+				return FStructBindingView(StaticCastSharedPtr<DI::FUStructBinding>(BindingInstance).ToSharedRef());
+			}
+			HandleResolveError(BindingKey, ErrorBehavior);
+			return {};
+		}
+
+		/**
+		 * Private so no one passes in a binding key that does not match T.
+		 * Nothing being bound for the key is not an error, it just means there are no instances.
+		 */
+		template <class T>
+		TConstArrayView<DI::TBindingInstRef<T>> GetAll(const FBindingKey& BindingKey) const
+		{
+			static_assert(CMultiBindingProvider<TDiContainer>, "The DI container can not hold multi bindings.");
+			if (const FMultiBinding* MultiBinding = DiContainer.FindMultiBinding(BindingKey))
+			{
+				return static_cast<const DI::TMultiBinding<T>*>(MultiBinding)->GetInstances();
+			}
+			return {};
+		}
+
+		/**
+		 * Bindings can exist without being able to resolve yet, like soft object bindings that have not been loaded.
+		 * Their factory is asked to make the instance available instead of subscribing to a bind that will never happen.
+		 * @return true if the promise has been taken and will be fulfilled once the instance is available.
+		 */
+		template <class T>
+		bool RequestFactoryInstance(const FBindingKey& BindingKey, TWeakPromise<TBindingInstRef<T>>& Promise) const
+		{
+			if constexpr (THasUClass<T>::Value)
+			{
+				const TSharedPtr<DI::FBinding> Binding = DiContainer.FindBinding(BindingKey);
+				if (!Binding.IsValid() || !Binding->IsResolvedByFactory())
+				{
+					return false;
+				}
+
+				// The request keeps the binding alive, so it can always be resolved when it is ready.
+				const TSharedRef<const TFactoryBinding<T>> FactoryBinding = StaticCastSharedRef<const TFactoryBinding<T>>(Binding.ToSharedRef());
+				if (!FactoryBinding->CanRequestInstance())
+				{
+					return false;
+				}
+				FactoryBinding->RequestInstance([FactoryBinding, Promise = MoveTemp(Promise)]() mutable
+				{
+					if (TBindingInstPtr<T> Instance = FactoryBinding->Resolve())
+					{
+						Promise.EmplaceValue(ToRefType(Instance));
+					}
+					else
+					{
+						Promise.Cancel();
+					}
+				});
+				return true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		template <class... Ts, size_t... Indices, class... TNames>
+		TWeakFutureSet<TBindingInstRef<Ts>...> WaitForManyResolved(
+			TTuple<DI::TBindingInstPtr<Ts>...> Resolved,
+			UObject* WaitingObject,
+			EResolveErrorBehavior ErrorBehavior,
+			std::index_sequence<Indices...>,
+			TNames... BindingNames) const
+		{
+			TTuple<TWeakFuture<TBindingInstRef<Ts>>...> Futures = TTuple<TWeakFuture<TBindingInstRef<Ts>>...>(
+				this->template WaitForNamedUnlessResolved<Ts>(Resolved.template Get<Indices>(), BindingNames, WaitingObject, ErrorBehavior)...
+			);
+			return AwaitAllInTuple(MoveTemp(Futures));
+		}
+
+		/** @return a completed future if the binding has been resolved already, otherwise waits for the binding. */
+		template <class T, class TName>
+		TWeakFuture<TBindingInstRef<T>> WaitForNamedUnlessResolved(
+			const DI::TBindingInstPtr<T>& Resolved,
+			const TName& BindingName,
+			UObject* WaitingObject,
+			EResolveErrorBehavior ErrorBehavior) const
+		{
+			if (Resolved)
+			{
+				auto [Promise, Future] = MakeWeakPromisePair<TBindingInstRef<T>>();
+				Promise.EmplaceValue(ToRefType(Resolved));
+				return MoveTemp(Future);
+			}
+			return this->template WaitForNamed<T>(BindingName, WaitingObject, ErrorBehavior);
+		}
+
+		/**
+		 * Batched version of Get. Containers that are a CBatchBindingProvider look up all keys in a single walk over their chain.
+		 */
+		template <class... Ts, size_t... Indices>
+		TTuple<DI::TBindingInstPtr<Ts>...> GetMany(TConstArrayView<FBindingKey> BindingKeys, EResolveErrorBehavior ErrorBehavior, std::index_sequence<Indices...>) const
+		{
+			if constexpr (CBatchBindingProvider<TDiContainer>)
+			{
+				DI::FBinding* Bindings[sizeof...(Ts)] = {};
+				// Declared bindings do not need a lookup. The batch skips all entries that are filled in already.
+				((Bindings[Indices] = this->template FindDeclaredBinding<Ts>(BindingKeys[Indices])), ...);
+				DiContainer.FindBorrowedBindings(BindingKeys, MakeArrayView(Bindings));
+				return MakeTuple(this->template ResolveBorrowed<Ts>(Bindings[Indices], BindingKeys[Indices], ErrorBehavior)...);
+			}
+			else
+			{
+				return MakeTuple(this->template Get<Ts>(BindingKeys[Indices], ErrorBehavior)...);
+			}
+		}
+
+		/** @return the binding of T if the container declares it statically. */
+		template <class T>
+		DI::FBinding* FindDeclaredBinding(const FBindingKey& BindingKey) const
+		{
+			static_assert(!CClosedDiContainer<TDiContainer> || CStaticBindingProvider<TDiContainer, T>,
+				"The DI container can never provide this type. Add the type to the types of the static DI container.");
+			if constexpr (CStaticBindingProvider<TDiContainer, T>)
+			{
+				if (!BindingKey.IsNamed())
+				{
+					return const_cast<TBindingType<T>*>(DiContainer.template FindStaticBinding<T>());
+				}
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Resolve a binding that has been looked up without keeping it alive.
+		 * Instance bindings are only read before returning, so they stay borrowed.
+		 * Factories run user code that can rebind or destroy containers and free the binding while it resolves, so their bindings are pinned.
+		 */
+		template <class T>
+		DI::TBindingInstPtr<T> ResolveBorrowed(const DI::FBinding* Binding, const FBindingKey& BindingKey, EResolveErrorBehavior ErrorBehavior) const
+		{
+			if (Binding)
+			{
+				if (UNLIKELY(Binding->IsResolvedByFactory()))
+				{
+					const TSharedPtr<DI::FBinding> PinnedBinding = DiContainer.FindBinding(BindingKey);
+					checkSlow(PinnedBinding.Get() == Binding);
+					return StaticCastSharedPtr<DI::TBindingType<T>>(PinnedBinding)->Resolve();
+				}
+				return static_cast<const DI::TBindingType<T>*>(Binding)->Resolve();
+			}
+			HandleResolveError(BindingKey, ErrorBehavior);
 			return {};
 		}
 
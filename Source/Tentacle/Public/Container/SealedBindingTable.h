@@ -0,0 +1,115 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Binding.h"
+#include "BindingKey.h"
+
+namespace DI
+{
+	/**
+	 * Immutable binding table with a perfect hash over its keys, built by hash and displace.
+	 *
+	 * Keys are hashed into buckets of a few keys each. Every bucket stores a displacement that has been searched when building the table,
+	 * so that the keys of the bucket land in slots that no other key uses. A lookup is two hashes, reading the displacement of the bucket
+	 * and a single key compare with no probing. The table has about a quarter more slots than keys, no matter how the keys are spread
+	 * over the process wide key indices.
+	 * The bindings themselves are stored contiguously in the order they were passed in.
+	 */
+	class TENTACLE_API FSealedBindingTable
+	{
+	public:
+		FSealedBindingTable();
+
+		/**
+		 * Build the table.
+		 * @param InBindings - the bindings to store. Keys must be unique.
+		 */
+		explicit FSealedBindingTable(TArray<TSharedPtr<FBinding>> InBindings);
+
+		FORCEINLINE const TSharedPtr<FBinding>* Find(const FBindingKey& Key) const
+		{
+			const uint64 KeyHash = HashKey(Key.GetIndex(), Seed);
+			const FSlot& Slot = Slots.GetData()[GetSlotIndex(KeyHash, Displacements.GetData()[GetBucketIndex(KeyHash)])];
+			return Slot.KeyIndex == Key.GetIndex() ? &Bindings[Slot.BindingIndex] : nullptr;
+		}
+
+		/**
+		 * Start loading the slot of Key so a Find for it shortly after does not stall on memory.
+		 * The displacements are a fraction of the size of the slots and stay in cache, so reading one here is cheap.
+		 */
+		FORCEINLINE void Prefetch(const FBindingKey& Key) const
+		{
+			const uint64 KeyHash = HashKey(Key.GetIndex(), Seed);
+			FPlatformMisc::Prefetch(Slots.GetData() + GetSlotIndex(KeyHash, Displacements.GetData()[GetBucketIndex(KeyHash)]));
+		}
+
+		FORCEINLINE int32 Num() const
+		{
+			return Bindings.Num();
+		}
+
+		/** @return the number of slots in the table. */
+		FORCEINLINE int32 GetNumSlots() const
+		{
+			return Slots.Num();
+		}
+
+		FORCEINLINE TConstArrayView<TSharedPtr<FBinding>> GetBindings() const
+		{
+			return Bindings;
+		}
+
+	private:
+		struct FSlot
+		{
+			// Key indices are never MAX_uint32, so this marks an empty slot.
+			uint32 KeyIndex = MAX_uint32;
+			uint32 BindingIndex = 0;
+		};
+
+		/** fmix64 of MurmurHash3. It is a bijection, so different keys never share a hash for the same seed. */
+		static FORCEINLINE uint64 HashKey(uint32 KeyIndex, uint32 InSeed)
+		{
+			uint64 Hash = (static_cast<uint64>(InSeed) << 32) | KeyIndex;
+			Hash ^= Hash >> 33;
+			Hash *= 0xff51afd7ed558ccdull;
+			Hash ^= Hash >> 33;
+			Hash *= 0xc4ceb9fe1a85ec53ull;
+			Hash ^= Hash >> 33;
+			return Hash;
+		}
+
+		/** Maps a 32 bit hash to [0, Range) with a multiply instead of a division. */
+		static FORCEINLINE uint32 ReduceToRange(uint32 Hash, uint32 Range)
+		{
+			return static_cast<uint32>((static_cast<uint64>(Hash) * Range) >> 32);
+		}
+
+		FORCEINLINE uint32 GetBucketIndex(uint64 KeyHash) const
+		{
+			return ReduceToRange(static_cast<uint32>(KeyHash >> 32), static_cast<uint32>(Displacements.Num()));
+		}
+
+		FORCEINLINE uint32 GetSlotIndex(uint64 KeyHash, uint32 Displacement) const
+		{
+			// fmix32 of MurmurHash3 so every displacement scatters the keys of a bucket differently.
+			uint32 SlotHash = static_cast<uint32>(KeyHash) ^ (Displacement * 0x9E3779B9u);
+			SlotHash ^= SlotHash >> 16;
+			SlotHash *= 0x85ebca6bu;
+			SlotHash ^= SlotHash >> 13;
+			SlotHash *= 0xc2b2ae35u;
+			SlotHash ^= SlotHash >> 16;
+			return ReduceToRange(SlotHash, static_cast<uint32>(Slots.Num()));
+		}
+
+		bool TryBuildSlots(uint32 InSeed, uint32 NumSlots);
+
+		TArray<FSlot> Slots;
+		/** One displacement per bucket. */
+		TArray<uint32> Displacements;
+		TArray<TSharedPtr<FBinding>> Bindings;
+		uint32 Seed = 0;
+	};
+}
@@ -0,0 +1,16 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FStreamableManager;
+
+namespace DI
+{
+	/**
+	 * @return the streamable manager that loads soft object bindings.
+	 * Tentacle owns its own manager so soft bindings work without an asset manager.
+	 */
+	TENTACLE_API FStreamableManager& GetSoftObjectStreamableManager();
+}
@@ -0,0 +1,397 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BindConflictBehavior.h"
+#include "BindingHelper.h"
+#include "BindingSubscriptionList.h"
+#include "BindResult.h"
+#include "Binding.h"
+#include "ChainedDiContainer.h"
+#include "DiContainerConcept.h"
+#include "Injector.h"
+#include "ResolveHelper.h"
+
+namespace DI
+{
+	namespace Private
+	{
+		template <class T, class... Ts>
+		constexpr int32 IndexOfType()
+		{
+			int32 Index = 0;
+			bool bFound = false;
+			((bFound = bFound || std::is_same_v<T, Ts>, Index += bFound ? 0 : 1), ...);
+			return bFound ? Index : INDEX_NONE;
+		}
+
+		template <class T, class... Ts>
+		constexpr bool IsTypeDeclared = (std::is_same_v<T, Ts> || ...);
+
+		template <class T, class... Ts>
+		constexpr int32 CountType()
+		{
+			return (0 + ... + (std::is_same_v<T, Ts> ? 1 : 0));
+		}
+
+		/**
+		 * Storage of the unnamed bindings of a static DI container.
+		 * All bindings live in one allocation. Bindings handed out through FindBinding alias this storage.
+		 */
+		template <class... Ts>
+		class TStaticBindingTuple
+		{
+		public:
+			static_assert(((CountType<Ts, Ts...>() == 1) && ...), "Every type may only be declared once per static DI container.");
+
+			template <class T>
+			FORCEINLINE TOptional<TBindingType<T>>& GetSlot()
+			{
+				return Bindings.template Get<IndexOfType<T, Ts...>()>();
+			}
+
+			template <class T>
+			FORCEINLINE const TOptional<TBindingType<T>>& GetSlot() const
+			{
+				return Bindings.template Get<IndexOfType<T, Ts...>()>();
+			}
+
+			/** @return the valid binding for T or nullptr. */
+			template <class T>
+			FORCEINLINE const TBindingType<T>* FindValid() const
+			{
+				const TOptional<TBindingType<T>>& Slot = GetSlot<T>();
+				return Slot.IsSet() && Slot->IsValid() ? &*Slot : nullptr;
+			}
+
+			/** @return the valid binding for BindingKey or nullptr. */
+			FBinding* FindValid(const FBindingKey& BindingKey) const
+			{
+				FBinding* Result = nullptr;
+				// Short circuits on the first declared type with a matching key.
+				(void)((BindingKey == MakeBindingKey<Ts>()
+					        ? (Result = const_cast<TBindingType<Ts>*>(FindValid<Ts>()), true)
+					        : false) || ...);
+				return Result;
+			}
+
+			void AddReferencedObjects(FReferenceCollector& Collector)
+			{
+				VisitTupleElements([&Collector](auto& Slot)
+				{
+					if (Slot.IsSet())
+					{
+						Slot->AddReferencedObjects(Collector);
+					}
+				}, Bindings);
+			}
+
+		private:
+			TTuple<TOptional<TBindingType<Ts>>...> Bindings;
+		};
+	}
+
+	/**
+	 * DI Container with a binding set that is fixed at compile time.
+	 *
+	 * Only unnamed bindings of the declared types can be bound. They are stored inline in a single allocation
+	 * and TryGet<T>, TryGetMany<Ts...> and the Inject API resolve them without any lookup.
+	 * Asking for a type that is not declared is a compile error.
+	 * Types can only be bound through Bind(), BindSpecific always rejects the binding.
+	 * @code
+	 * DI::TStaticDiContainer<USimpleUService, FSimpleNativeService> DiContainer;
+	 * DiContainer.Bind().Instance<USimpleUService>(Service);
+	 * TObjectPtr<USimpleUService> Resolved = DiContainer.Resolve().TryGet<USimpleUService>();
+	 * @endcode
+	 */
+	template <class... Ts>
+	class TStaticDiContainer
+	{
+	public:
+		static constexpr bool bResolvesUndeclaredBindings = false;
+
+		TStaticDiContainer() = default;
+
+		// Copying is usually a user error, so we delete it to catch these cases earlier.
+		TStaticDiContainer(const TStaticDiContainer&) = delete;
+
+		// - DiContainerConcept
+		/** Type erased bindings can not be stored in a static container. Use Bind() instead. */
+		EBindResult BindSpecific(TSharedRef<DI::FBinding> SpecificBinding, EBindConflictBehavior ConflictBehavior)
+		{
+			HandleBindingRejected(SpecificBinding->GetId(), EBindRejectReason::TypeErasedBindingInStaticContainer, ConflictBehavior);
+			return EBindResult::Rejected;
+		}
+
+		/** Find a binding by its key. The returned binding shares ownership of the whole container storage. */
+		TSharedPtr<DI::FBinding> FindBinding(const FBindingKey& BindingKey) const
+		{
+			if (FBinding* Binding = Storage->FindValid(BindingKey))
+			{
+				return TSharedPtr<DI::FBinding>(Storage, Binding);
+			}
+			return nullptr;
+		}
+
+		// - CBorrowedBindingProvider
+		FORCEINLINE DI::FBinding* FindBorrowedBinding(const FBindingKey& BindingKey) const
+		{
+			return Storage->FindValid(BindingKey);
+		}
+		// --
+
+		/**
+		 * Get the delegate that will be invoked a single time when the binding with the given key is bound.
+		 * If the binding is already bound the event will never fire.
+		 * @param BindingKey the key of the binding to be notified about.
+		 */
+		FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingKey& BindingKey) const
+		{
+			return Subscriptions.SubscribeOnce(BindingKey);
+		}
+		// --
+
+		// - CStaticBindingProvider
+		template <class T> requires Private::IsTypeDeclared<T, Ts...>
+		FORCEINLINE const TBindingType<T>* FindStaticBinding() const
+		{
+			return Storage->template FindValid<T>();
+		}
+		// --
+
+		// - CBindingEmplacer
+		template <class T>
+		EBindResult EmplaceBinding(const FBindingId& BindingId, TBindingInstRef<T> Instance, EBindConflictBehavior ConflictBehavior)
+		{
+			static_assert(Private::IsTypeDeclared<T, Ts...>, "The type has to be declared in the types of the static DI container to be bound.");
+			if (!BindingId.GetBindingName().IsNone())
+			{
+				HandleBindingRejected(BindingId, EBindRejectReason::NamedBindingInStaticContainer, ConflictBehavior);
+				return EBindResult::Rejected;
+			}
+
+			TOptional<TBindingType<T>>& Slot = Storage->template GetSlot<T>();
+			if (Slot.IsSet() && Slot->IsValid())
+			{
+				HandleBindingConflict(BindingId, ConflictBehavior);
+				return EBindResult::Conflict;
+			}
+			Slot.Emplace(BindingId, Instance);
+			Subscriptions.NotifyInstanceBound(*Slot);
+			return EBindResult::Bound;
+		}
+		// --
+
+		/**
+		 * Unsubscribe from being notified about a binding.
+		 * @param BindingKey The key of the binding where there is a subscription
+		 * @param DelegateHandle The handle that was returned when the subscription was created
+		 * @return true if there was a subscription and it has been successfully removed.
+		 */
+		bool Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle) const
+		{
+			return Subscriptions.Unsubscribe(BindingKey, DelegateHandle);
+		}
+
+		/** Call this from the owning type to prevent types and bindings to be garbage collected. */
+		void AddReferencedObjects(FReferenceCollector& Collector)
+		{
+			Storage->AddReferencedObjects(Collector);
+		}
+
+		/** Get the Binding API */
+		TBindingHelper<TStaticDiContainer> Bind() { return TBindingHelper<TStaticDiContainer>(*this); }
+		/** Get the Resolving API */
+		TResolveHelper<TStaticDiContainer> Resolve() const { return TResolveHelper<TStaticDiContainer>(*this); }
+		/** Get the Injection API */
+		TInjector<TStaticDiContainer> Inject() { return TInjector<TStaticDiContainer>(*this); }
+
+	private:
+		TSharedRef<Private::TStaticBindingTuple<Ts...>> Storage = MakeShared<Private::TStaticBindingTuple<Ts...>>();
+		mutable FBindingSubscriptionList Subscriptions;
+	};
+
+	/**
+	 * Static DI Container that defers everything it does not declare to a dynamic parent.
+	 *
+	 * Declared types are stored and resolved like in TStaticDiContainer.
+	 * All other types are resolved from the parent and waiting for them subscribes to the parent.
+	 * @note Waiting for a declared type only completes when it is bound in this container.
+	 */
+	template <class... Ts>
+	class TChainedStaticDiContainer
+	{
+	public:
+		static constexpr bool bResolvesUndeclaredBindings = true;
+
+		TChainedStaticDiContainer() = default;
+
+		explicit TChainedStaticDiContainer(TSharedPtr<FChainedDiContainer> InParentContainer)
+			: ParentContainer(InParentContainer), BorrowedParentContainer(InParentContainer.Get())
+		{
+		}
+
+		// Copying is usually a user error, so we delete it to catch these cases earlier.
+		TChainedStaticDiContainer(const TChainedStaticDiContainer&) = delete;
+
+		/**
+		 * Sets the parent that undeclared types are resolved from.
+		 * @warning This has to happen before any async resolves are performed.
+		 */
+		void SetParentContainer(TSharedPtr<FChainedDiContainer> InParentContainer)
+		{
+			ParentContainer = InParentContainer;
+			BorrowedParentContainer = InParentContainer.Get();
+		}
+
+		// - DiContainerConcept
+		/** Type erased bindings can not be stored in a static container. Use Bind() instead. */
+		EBindResult BindSpecific(TSharedRef<DI::FBinding> SpecificBinding, EBindConflictBehavior ConflictBehavior)
+		{
+			HandleBindingRejected(SpecificBinding->GetId(), EBindRejectReason::TypeErasedBindingInStaticContainer, ConflictBehavior);
+			return EBindResult::Rejected;
+		}
+
+		/** Find a binding by its key. Declared bindings share ownership of the whole container storage. */
+		TSharedPtr<DI::FBinding> FindBinding(const FBindingKey& BindingKey) const
+		{
+			if (FBinding* Binding = Storage->FindValid(BindingKey))
+			{
+				return TSharedPtr<DI::FBinding>(Storage, Binding);
+			}
+			if (TSharedPtr<FChainedDiContainer> PinnedParent = ParentContainer.Pin())
+			{
+				return PinnedParent->FindBinding(BindingKey);
+			}
+			return nullptr;
+		}
+
+		// - CBorrowedBindingProvider
+		DI::FBinding* FindBorrowedBinding(const FBindingKey& BindingKey) const
+		{
+			if (FBinding* Binding = Storage->FindValid(BindingKey))
+			{
+				return Binding;
+			}
+			if (BorrowedParentContainer && ParentContainer.IsValid())
+			{
+				return BorrowedParentContainer->FindBorrowedBinding(BindingKey);
+			}
+			return nullptr;
+		}
+		// --
+
+		// - CBatchBindingProvider
+		void FindBorrowedBindings(TConstArrayView<FBindingKey> BindingKeys, TArrayView<DI::FBinding*> OutBindings) const
+		{
+			check(BindingKeys.Num() == OutBindings.Num());
+			bool bNeedsParent = false;
+			for (int32 Index = 0; Index < BindingKeys.Num(); ++Index)
+			{
+				if (!OutBindings[Index])
+				{
+					OutBindings[Index] = Storage->FindValid(BindingKeys[Index]);
+					bNeedsParent |= OutBindings[Index] == nullptr;
+				}
+			}
+			if (bNeedsParent && BorrowedParentContainer && ParentContainer.IsValid())
+			{
+				BorrowedParentContainer->FindBorrowedBindings(BindingKeys, OutBindings);
+			}
+		}
+		// --
+
+		/**
+		 * Get the delegate that will be invoked a single time when the binding with the given key is bound.
+		 * If the binding is already bound the event will never fire.
+		 * @param BindingKey the key of the binding to be notified about.
+		 */
+		FBindingSubscriptionList::FOnInstanceBound& Subscribe(const FBindingKey& BindingKey) const
+		{
+			if (!IsDeclared(BindingKey))
+			{
+				if (TSharedPtr<FChainedDiContainer> PinnedParent = ParentContainer.Pin())
+				{
+					return PinnedParent->Subscribe(BindingKey);
+				}
+			}
+			return Subscriptions.SubscribeOnce(BindingKey);
+		}
+		// --
+
+		// - CStaticBindingProvider
+		template <class T> requires Private::IsTypeDeclared<T, Ts...>
+		FORCEINLINE const TBindingType<T>* FindStaticBinding() const
+		{
+			return Storage->template FindValid<T>();
+		}
+		// --
+
+		// - CBindingEmplacer
+		template <class T>
+		EBindResult EmplaceBinding(const FBindingId& BindingId, TBindingInstRef<T> Instance, EBindConflictBehavior ConflictBehavior)
+		{
+			static_assert(Private::IsTypeDeclared<T, Ts...>, "The type has to be declared in the types of the static DI container to be bound.");
+			if (!BindingId.GetBindingName().IsNone())
+			{
+				HandleBindingRejected(BindingId, EBindRejectReason::NamedBindingInStaticContainer, ConflictBehavior);
+				return EBindResult::Rejected;
+			}
+
+			TOptional<TBindingType<T>>& Slot = Storage->template GetSlot<T>();
+			if (Slot.IsSet() && Slot->IsValid())
+			{
+				HandleBindingConflict(BindingId, ConflictBehavior);
+				return EBindResult::Conflict;
+			}
+			Slot.Emplace(BindingId, Instance);
+			Subscriptions.NotifyInstanceBound(*Slot);
+			return EBindResult::Bound;
+		}
+		// --
+
+		/**
+		 * Unsubscribe from being notified about a binding.
+		 * @param BindingKey The key of the binding where there is a subscription
+		 * @param DelegateHandle The handle that was returned when the subscription was created
+		 * @return true if there was a subscription and it has been successfully removed.
+		 */
+		bool Unsubscribe(const FBindingKey& BindingKey, FDelegateHandle DelegateHandle) const
+		{
+			if (!IsDeclared(BindingKey))
+			{
+				if (TSharedPtr<FChainedDiContainer> PinnedParent = ParentContainer.Pin())
+				{
+					return PinnedParent->Unsubscribe(BindingKey, DelegateHandle);
+				}
+			}
+			return Subscriptions.Unsubscribe(BindingKey, DelegateHandle);
+		}
+
+		/** Call this from the owning type to prevent types and bindings to be garbage collected. */
+		void AddReferencedObjects(FReferenceCollector& Collector)
+		{
+			Storage->AddReferencedObjects(Collector);
+		}
+
+		/** Get the Binding API */
+		TBindingHelper<TChainedStaticDiContainer> Bind() { return TBindingHelper<TChainedStaticDiContainer>(*this); }
+		/** Get the Resolving API */
+		TResolveHelper<TChainedStaticDiContainer> Resolve() const { return TResolveHelper<TChainedStaticDiContainer>(*this); }
+		/** Get the Injection API */
+		TInjector<TChainedStaticDiContainer> Inject() { return TInjector<TChainedStaticDiContainer>(*this); }
+
+	private:
+		static bool IsDeclared(const FBindingKey& BindingKey)
+		{
+			return ((BindingKey == MakeBindingKey<Ts>()) || ...);
+		}
+
+		TSharedRef<Private::TStaticBindingTuple<Ts...>> Storage = MakeShared<Private::TStaticBindingTuple<Ts...>>();
+		mutable FBindingSubscriptionList Subscriptions;
+		TWeakPtr<FChainedDiContainer> ParentContainer;
+		// Raw alias of ParentContainer so borrowed lookups can skip pinning. Only dereferenced while ParentContainer is valid.
+		FChainedDiContainer* BorrowedParentContainer = nullptr;
+	};
+}
@@ -0,0 +1,94 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Binding.h"
+#include "StructUtils/StructView.h"
+
+namespace DI
+{
+	/**
+	 * Read only view of the struct data of a UStruct binding.
+	 * The view shares ownership of the binding, so the memory stays valid for as long as the view exists,
+	 * even if the binding is replaced or its container is destroyed in the meantime.
+	 * The garbage collector only learns about the struct type and the UObjects the struct references through the container, though.
+	 * Owners of views that can outlive the container have to call AddReferencedObjects, unless the struct is plain data.
+	 * Use this instead of copying out large structs that are read often.
+	 * @code
+	 * DI::FStructBindingView TuningView = DiContainer.Resolve().TryGetStructView<FTuningTable>();
+	 * if (const FTuningTable* TuningTable = TuningView.GetPtr<FTuningTable>())
+	 * {
+	 *     Speed = TuningTable->Speed;
+	 * }
+	 * @endcode
+	 */
+	class FStructBindingView
+	{
+	public:
+		FStructBindingView() = default;
+
+		explicit FStructBindingView(TSharedRef<FUStructBinding> InBinding)
+			: Binding(MoveTemp(InBinding))
+		{
+		}
+
+		FORCEINLINE bool IsValid() const
+		{
+			return Binding.IsValid();
+		}
+
+		explicit operator bool() const
+		{
+			return IsValid();
+		}
+
+		/** @return the type of the viewed struct or nullptr if the view is empty. */
+		const UScriptStruct* GetScriptStruct() const
+		{
+			return Binding.IsValid() ? Binding->GetStruct() : nullptr;
+		}
+
+		/** @return the struct memory owned by the binding or nullptr if the view is empty. */
+		const uint8* GetMemory() const
+		{
+			return Binding.IsValid() ? Binding->GetMemory() : nullptr;
+		}
+
+		/**
+		 * @tparam T struct type to access the memory as. Has to be exactly the bound struct type.
+		 * @return the viewed struct or nullptr if the view is empty or holds a different struct type.
+		 */
+		template <class T>
+		const T* GetPtr() const
+		{
+			if (GetScriptStruct() != T::StaticStruct())
+			{
+				return nullptr;
+			}
+			return reinterpret_cast<const T*>(Binding->GetMemory());
+		}
+
+		/**
+		 * @return a FConstStructView of the binding memory for APIs that take struct views.
+		 * The returned view does not keep the binding alive, so it must not outlive this view.
+		 */
+		FConstStructView GetStructView() const
+		{
+			return FConstStructView(GetScriptStruct(), GetMemory());
+		}
+
+		/** Call this from the owning type to keep the struct type and the UObjects referenced by the struct alive. */
+		void AddReferencedObjects(FReferenceCollector& Collector)
+		{
+			if (Binding.IsValid())
+			{
+				Binding->AddReferencedObjects(Collector);
+			}
+		}
+
+	private:
+		// Not const because AddReferencedObjects may update the references held by the struct.
+		TSharedPtr<FUStructBinding> Binding;
+	};
+}
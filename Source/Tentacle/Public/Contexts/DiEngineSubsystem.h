@@ -21,6 +21,7 @@ class TENTACLE_API UDiEngineSubsystem : public UEngineSubsystem, public IDiConte
 
 public:
 	// - USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	// - IDIContextInterface
 	virtual DI::FChainedDiContainer& GetDiContainer() override { return *DiContainerGCd.DiContainer; };
@@ -6,6 +6,8 @@
 #include "TentacleTemplates.h"
 #include "UObject/Object.h"
 
+#include <atomic>
+
 
 namespace DI
 {
@@ -16,10 +18,23 @@ uint32 GetTypeHash(const DI::FTypeId& TypeId);
 
 namespace DI
 {
-	namespace Private
+	/**
+	 * Identity of a native type.
+	 * One constexpr tag is defined per type by the DI_DEFINE_*_NATIVE_TYPEID macros. Its address is the type id.
+	 */
+	struct FNativeTypeTag
 	{
-		FTypeId MakeNativeTypeId(const TCHAR* TypeName);
+		const TCHAR* Name;
 
+		/**
+		 * Native type ids point at Marker[1]. It sits at an odd address, which an UStruct never does,
+		 * so FTypeId can tell both apart from the low bit without losing constexpr construction.
+		 */
+		uint8 Marker[2] = {};
+	};
+
+	namespace Private
+	{
 		//@see https://stackoverflow.com/a/38637849
 		template <typename... Ts>
 		struct TAlwaysFalse : std::false_type
@@ -43,173 +58,118 @@ namespace DI
  */
 class TENTACLE_API FTypeId
 {
-	friend FTypeId Private::MakeNativeTypeId(const TCHAR* TypeName);
-	friend auto ::GetTypeHash(const FTypeId&) -> uint32;
-
-private:
-	enum class EIdType : uint8
-	{
-		Invalid = 255,
-		UType = 0,
-		NativeType = 1,
-	};
-
-	EIdType Type = EIdType::Invalid;
-
-	union
-	{
-		TObjectPtr<UStruct> UType;
-		const TCHAR* NativeClassId;
-	};
-
-	explicit FTypeId(const TCHAR* ClassId)
-		: Type(EIdType::NativeType), NativeClassId(ClassId)
-	{
-	}
-
 public:
-	FTypeId()
-		: Type(EIdType::Invalid),
-		  UType(nullptr)
-	{
-	}
+	constexpr FTypeId() = default;
 
-	FTypeId(const FTypeId& Other)
+	explicit constexpr FTypeId(const FNativeTypeTag& InNativeTypeTag)
+		: TaggedPointer(&InNativeTypeTag.Marker[NativeTagBit])
 	{
-		*this = Other;
 	}
 
-	FTypeId(FTypeId&& Other)
+	explicit constexpr FTypeId(UStruct* TypeClass)
+		: TaggedPointer(TypeClass)
 	{
-		*this = MoveTemp(Other);
 	}
 
-	FTypeId& operator=(const FTypeId& Other)
-	{
-		Type = Other.Type;
-		switch (Other.Type)
-		{
-		case EIdType::Invalid:
-			break;
-		case EIdType::UType:
-			UType = Other.UType;
-			break;
-		case EIdType::NativeType:
-			NativeClassId = Other.NativeClassId;
-			break;
-		}
-		return *this;
-	}
+	static const FTypeId InvalidId; 
 
-	FTypeId& operator=(FTypeId&& Other)
+	FName GetName() const;
+
+	FORCEINLINE bool IsNativeType() const
 	{
-		Type = Other.Type;
-		switch (Other.Type)
-		{
-		case EIdType::Invalid:
-			break;
-		case EIdType::UType:
-			UType = Other.UType;
-			break;
-		case EIdType::NativeType:
-			NativeClassId = Other.NativeClassId;
-			break;
-		}
-		Other.Type = EIdType::Invalid;
-		Other.UType = nullptr;
-		return *this;
+		return (reinterpret_cast<UPTRINT>(TaggedPointer) & NativeTagBit) != 0;
 	}
 
-	explicit FTypeId(UStruct* TypeClass)
-		: Type(EIdType::UType), UType(TypeClass)
+	FORCEINLINE UStruct* TryGetUType() const
 	{
+		return IsNativeType() ? nullptr : static_cast<UStruct*>(const_cast<void*>(TaggedPointer));
 	}
 
-	static const FTypeId InvalidId; 
-
-	FName GetName() const;
-
-	UStruct* TryGetUType() const
+	FORCEINLINE const FNativeTypeTag* TryGetNativeTypeTag() const
 	{
-		if (Type == EIdType::UType)
+		if (!IsNativeType())
 		{
-			return UType;
+			return nullptr;
 		}
-		return nullptr;
+		const UPTRINT MarkerAddress = reinterpret_cast<UPTRINT>(TaggedPointer) - NativeTagBit;
+		return reinterpret_cast<const FNativeTypeTag*>(MarkerAddress - STRUCT_OFFSET(FNativeTypeTag, Marker));
 	}
 
 	void AddReferencedObjects(FReferenceCollector& Collector)
 	{
-		if (Type == EIdType::UType)
+		if (UStruct* UType = TryGetUType())
 		{
 			Collector.AddReferencedObject(UType);
+			TaggedPointer = UType;
 		}
 	}
 
-	const void* GetTypeIdAddress() const
+	/** @return an address that is unique for the type. */
+	FORCEINLINE constexpr const void* GetTypeIdAddress() const
 	{
-		switch (Type)
-		{
-		case EIdType::Invalid:
-		default:
-			return nullptr;
-		case EIdType::UType:
-			return UType;
-		case EIdType::NativeType:
-			return NativeClassId;
-		}
+		return TaggedPointer;
 	}
 
-	FORCEINLINE bool operator==(const FTypeId& Other) const
+	FORCEINLINE constexpr bool operator==(const FTypeId& Other) const
 	{
-		return
-			Type == Other.Type
-			&& GetTypeIdAddress() == Other.GetTypeIdAddress();
+		return TaggedPointer == Other.TaggedPointer;
 	}
+
+private:
+	static constexpr UPTRINT NativeTagBit = 1;
+
+	/** Either an UStruct* or the address of FNativeTypeTag::Marker[1]. nullptr for the invalid id. */
+	const void* TaggedPointer = nullptr;
 };
 
+static_assert(sizeof(FTypeId) == sizeof(void*));
+static_assert(alignof(FNativeTypeTag) > 1 && STRUCT_OFFSET(FNativeTypeTag, Marker) % 2 == 0, "FNativeTypeTag::Marker[1] has to have an odd address");
+
 }
 
 FORCEINLINE uint32 GetTypeHash(const DI::FTypeId& TypeId)
 {
-	return HashCombine(GetTypeHash(TypeId.Type), GetTypeHash(TypeId.GetTypeIdAddress()));
+	return GetTypeHash(TypeId.GetTypeIdAddress());
 }
 
-#define DI_TYPEID_BODY(TypeName)\
-	static_assert(sizeof(TypeName) != 0, #TypeName " does not name a type.");\
-	static const TCHAR* TypeName ## TypeName = TEXT(PREPROCESSOR_TO_STRING(TypeName)); \
-	static const ::DI::FTypeId TypeName ## TypeId = ::DI::Private::MakeNativeTypeId(TypeName ## TypeName);\
-	return TypeName ## TypeId;
+#define DI_NATIVE_TYPE_TAG_INITIALIZER(TypeName)\
+	{ TEXT(PREPROCESSOR_TO_STRING(TypeName)) }
 
 /**
  * Use this to define a typeID inside a type.
  * Use for types that you wrote yourself and where you can edit the source files.
+ * The type id is a compile time constant.
  * @param TypeName Type of the class. Can include namespace declarations.
  */
 #define DI_DEFINE_NATIVE_TYPEID_MEMBER(TypeName)\
-		FORCEINLINE static const ::DI::FTypeId& GetTypeId()\
+		static constexpr ::DI::FNativeTypeTag DiNativeTypeTag = DI_NATIVE_TYPE_TAG_INITIALIZER(TypeName);\
+		FORCEINLINE static constexpr ::DI::FTypeId GetTypeId()\
 		{ \
-			DI_TYPEID_BODY(TypeName)\
+			static_assert(sizeof(TypeName) != 0, #TypeName " does not name a type.");\
+			return ::DI::FTypeId(DiNativeTypeTag);\
 		}
 
 
 #define DI_DECLARE_FREE_NATIVE_TYPEID(API_MACRO, TypeName)\
 	namespace DI {\
 		template<>\
-		const FTypeId& GetFreeTypeId<TypeName>();\
+		FTypeId GetFreeTypeId<TypeName>();\
 	}
 
 /**
  * Use this to define a typeID outside the type.
  * Use for types that are defined in foreign code where you can't define the typeID as a member function.
+ * The tag is constant initialized so resolving the type id does not need a static initialization guard.
  * @param TypeName Type of the class. Can include namespace declarations.
  */
 #define DI_DEFINE_FREE_NATIVE_TYPEID(TypeName)\
 	namespace DI {\
 		template<>\
-		const FTypeId& GetFreeTypeId<TypeName>()\
+		FTypeId GetFreeTypeId<TypeName>()\
 		{ \
-			DI_TYPEID_BODY(TypeName)\
+			static_assert(sizeof(TypeName) != 0, #TypeName " does not name a type.");\
+			static constexpr FNativeTypeTag NativeTypeTag = DI_NATIVE_TYPE_TAG_INITIALIZER(TypeName);\
+			return FTypeId(NativeTypeTag);\
 		}\
 	}
 
@@ -229,7 +189,7 @@ namespace DI
 	};
 
 	template <class T>
-	const FTypeId& GetFreeTypeId()
+	FTypeId GetFreeTypeId()
 	{
 		static_assert(
 			Private::TAlwaysFalse<T>::value,
@@ -239,33 +199,40 @@ namespace DI
 		return FTypeId::InvalidId;
 	}
 
+	namespace Private
+	{
+		/**
+		 * Per type cache of the UStruct. Constant initialized, so unlike a function local static it needs no initialization guard.
+		 * Racing threads store the same pointer.
+		 */
+		template <class T>
+		inline std::atomic<UStruct*> CachedUStruct = nullptr;
+	}
+
 	template <class T>
-	typename TEnableIf<THasUStruct<T>::Value, const FTypeId&>::Type
+	typename TEnableIf<THasUStruct<T>::Value, FTypeId>::Type
 	GetTypeId() /* -> FTypeId */
 	{
-		static const FTypeId StaticUStructId = FTypeId(GetStaticClass<T>());
-		return StaticUStructId;
+		UStruct* UStructType = Private::CachedUStruct<T>.load(std::memory_order_relaxed);
+		if (UNLIKELY(!UStructType))
+		{
+			UStructType = GetStaticClass<T>();
+			Private::CachedUStruct<T>.store(UStructType, std::memory_order_relaxed);
+		}
+		return FTypeId(UStructType);
 	}
 
 	template <class T>
-	typename TEnableIf<TModels<CNativeMemberTypeIdProvider, T>::Value, const FTypeId&>::Type
+	constexpr typename TEnableIf<TModels<CNativeMemberTypeIdProvider, T>::Value, FTypeId>::Type
 	GetTypeId() /* -> FTypeId */
 	{
 		return T::GetTypeId();
 	}
 
 	template <class T>
-	typename TEnableIf<!TOr<THasUStruct<T>, TModels<CNativeMemberTypeIdProvider, T>>::Value, const FTypeId&>::Type
+	typename TEnableIf<!TOr<THasUStruct<T>, TModels<CNativeMemberTypeIdProvider, T>>::Value, FTypeId>::Type
 	GetTypeId() /* -> FTypeId */
 	{
 		return ::DI::GetFreeTypeId<T>();
 	}
-
-	namespace Private
-	{
-		FORCEINLINE FTypeId MakeNativeTypeId(const TCHAR* TypeName)
-		{
-			return FTypeId(TypeName);
-		}
-	}
 }
@@ -0,0 +1,73 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingArena.h"
+#include "Mocks/SimpleService.h"
+
+BEGIN_DEFINE_SPEC(BindingArenaSpec, "Tentacle.BindingArena",
+                  EAutomationTestFlags::EngineFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProgramContext)
+END_DEFINE_SPEC(BindingArenaSpec)
+
+void BindingArenaSpec::Define()
+{
+	Describe("Emplace", [this]
+	{
+		It("should construct bindings that resolve their instance", [this]
+		{
+			TRefCountPtr<DI::FBindingArena> Arena = new DI::FBindingArena();
+			TSharedRef<FSimpleNativeService> Service = MakeShared<FSimpleNativeService>(20);
+			TSharedRef<DI::TBindingType<FSimpleNativeService>> Binding = Arena->Emplace<DI::TBindingType<FSimpleNativeService>>(DI::MakeBindingId<FSimpleNativeService>(), Service);
+			TestEqual("Binding->Resolve()", Binding->Resolve(), Service);
+			TestEqual("Arena->Num()", Arena->Num(), 1);
+		});
+		It("should keep many bindings across slabs alive", [this]
+		{
+			TRefCountPtr<DI::FBindingArena> Arena = new DI::FBindingArena();
+			TArray<TSharedRef<DI::TBindingType<FSimpleNativeService>>> Bindings;
+			for (int32 i = 0; i < 200; ++i)
+			{
+				Bindings.Add(Arena->Emplace<DI::TBindingType<FSimpleNativeService>>(DI::MakeBindingId<FSimpleNativeService>(), MakeShared<FSimpleNativeService>(i)));
+			}
+			for (int32 i = 0; i < Bindings.Num(); ++i)
+			{
+				TestEqual("Bindings[i]->Resolve()->A", Bindings[i]->Resolve()->A, i);
+			}
+		});
+	});
+	Describe("Lifetime", [this]
+	{
+		It("should destroy bindings once the arena and all bindings are released", [this]
+		{
+			TSharedRef<FSimpleNativeService> Service = MakeShared<FSimpleNativeService>();
+			TSharedPtr<DI::FBinding> Binding;
+			{
+				TRefCountPtr<DI::FBindingArena> Arena = new DI::FBindingArena();
+				Binding = Arena->Emplace<DI::TBindingType<FSimpleNativeService>>(DI::MakeBindingId<FSimpleNativeService>(), Service);
+			}
+			TestEqual("Service.GetSharedReferenceCount() while the binding is referenced", Service.GetSharedReferenceCount(), 2);
+			Binding.Reset();
+			TestEqual("Service.GetSharedReferenceCount() after release", Service.GetSharedReferenceCount(), 1);
+		});
+		It("should destroy a binding once its own references are released", [this]
+		{
+			TRefCountPtr<DI::FBindingArena> Arena = new DI::FBindingArena();
+			TSharedRef<FSimpleNativeService> Service = MakeShared<FSimpleNativeService>();
+			TSharedPtr<DI::FBinding> Binding = Arena->Emplace<DI::TBindingType<FSimpleNativeService>>(DI::MakeBindingId<FSimpleNativeService>(), Service);
+			TSharedPtr<DI::FBinding> OtherBinding = Arena->Emplace<DI::TBindingType<FSimpleNativeService>>(DI::MakeBindingId<FSimpleNativeService>(), MakeShared<FSimpleNativeService>());
+
+			Binding.Reset();
+			TestEqual("Service.GetSharedReferenceCount()", Service.GetSharedReferenceCount(), 1);
+			TestEqual("Arena->Num()", Arena->Num(), 1);
+		});
+		It("should reuse the memory of destroyed bindings", [this]
+		{
+			TRefCountPtr<DI::FBindingArena> Arena = new DI::FBindingArena();
+			TSharedPtr<DI::FBinding> Binding = Arena->Emplace<DI::TBindingType<FSimpleNativeService>>(DI::MakeBindingId<FSimpleNativeService>(), MakeShared<FSimpleNativeService>());
+			const DI::FBinding* FirstAddress = Binding.Get();
+			Binding.Reset();
+
+			Binding = Arena->Emplace<DI::TBindingType<FSimpleNativeService>>(DI::MakeBindingId<FSimpleNativeService>(), MakeShared<FSimpleNativeService>());
+			TestEqual("Binding.Get()", static_cast<const DI::FBinding*>(Binding.Get()), FirstAddress);
+		});
+	});
+}
@@ -0,0 +1,90 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingIndex.h"
+#include "Mocks/SimpleService.h"
+
+BEGIN_DEFINE_SPEC(BindingIndexSpec, "Tentacle.BindingIndex",
+                  EAutomationTestFlags::EngineFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProgramContext)
+
+	DI::TBindingIndex<int32> BindingIndex;
+	TArray<DI::FBindingKey> Keys;
+END_DEFINE_SPEC(BindingIndexSpec)
+
+void BindingIndexSpec::Define()
+{
+	BeforeEach([this]
+	{
+		BindingIndex.Empty();
+		Keys.Reset();
+		// Enough keys to force the table to grow a few times.
+		for (int32 i = 0; i < 100; ++i)
+		{
+			Keys.Add(DI::MakeBindingKey<USimpleUService>(FName("BindingIndexSpec", i + 1)));
+		}
+	});
+	Describe("Emplace", [this]
+	{
+		It("should find all added keys after growing", [this]
+		{
+			for (int32 i = 0; i < Keys.Num(); ++i)
+			{
+				BindingIndex.Emplace(Keys[i], i);
+			}
+			TestEqual("BindingIndex.Num()", BindingIndex.Num(), Keys.Num());
+			for (int32 i = 0; i < Keys.Num(); ++i)
+			{
+				const int32* Value = BindingIndex.Find(Keys[i]);
+				if (TestNotNull("BindingIndex.Find(Keys[i])", Value))
+				{
+					TestEqual("*BindingIndex.Find(Keys[i])", *Value, i);
+				}
+			}
+		});
+		It("should replace the value of an existing key", [this]
+		{
+			BindingIndex.Emplace(Keys[0], 1);
+			BindingIndex.Emplace(Keys[0], 2);
+			TestEqual("BindingIndex.Num()", BindingIndex.Num(), 1);
+			TestEqual("*BindingIndex.Find(Keys[0])", *BindingIndex.Find(Keys[0]), 2);
+		});
+	});
+	Describe("Remove", [this]
+	{
+		It("should only remove the given key", [this]
+		{
+			for (int32 i = 0; i < Keys.Num(); ++i)
+			{
+				BindingIndex.Emplace(Keys[i], i);
+			}
+			for (int32 i = 0; i < Keys.Num(); i += 2)
+			{
+				TestTrue("BindingIndex.Remove(Keys[i])", BindingIndex.Remove(Keys[i]));
+			}
+			TestEqual("BindingIndex.Num()", BindingIndex.Num(), Keys.Num() / 2);
+			for (int32 i = 0; i < Keys.Num(); ++i)
+			{
+				TestEqual("BindingIndex.Contains(Keys[i])", BindingIndex.Contains(Keys[i]), i % 2 == 1);
+			}
+		});
+	});
+	Describe("Iterator", [this]
+	{
+		It("should visit every element once", [this]
+		{
+			for (int32 i = 0; i < Keys.Num(); ++i)
+			{
+				BindingIndex.Emplace(Keys[i], i);
+			}
+			int32 Sum = 0;
+			int32 Count = 0;
+			for (auto It = BindingIndex.CreateConstIterator(); It; ++It)
+			{
+				Sum += It.Value();
+				++Count;
+			}
+			TestEqual("Count", Count, Keys.Num());
+			TestEqual("Sum", Sum, Keys.Num() * (Keys.Num() - 1) / 2);
+		});
+	});
+}
@@ -0,0 +1,66 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingKey.h"
+#include "Mocks/SimpleService.h"
+
+BEGIN_DEFINE_SPEC(BindingKeySpec, "Tentacle.BindingKey",
+                  EAutomationTestFlags::EngineFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProgramContext)
+END_DEFINE_SPEC(BindingKeySpec)
+
+void BindingKeySpec::Define()
+{
+	Describe("Constructor", [this]
+	{
+		It("should be invalid by default", [this]
+		{
+			TestFalse("DI::FBindingKey().IsValid()", DI::FBindingKey().IsValid());
+		});
+		It("should intern equal binding ids to the same key", [this]
+		{
+			const DI::FBindingKey A = DI::FBindingKey(DI::MakeBindingId<USimpleUService>("SomeName"));
+			const DI::FBindingKey B = DI::FBindingKey(DI::MakeBindingId<USimpleUService>("SomeName"));
+			TestTrue("A.IsValid()", A.IsValid());
+			TestEqual("A.GetIndex()", A.GetIndex(), B.GetIndex());
+		});
+		It("should intern different binding ids to different keys", [this]
+		{
+			TestNotEqual("Unnamed vs named",
+			             DI::MakeBindingKey<USimpleUService>().GetIndex(),
+			             DI::MakeBindingKey<USimpleUService>("SomeName").GetIndex());
+			TestNotEqual("UObject vs native",
+			             DI::MakeBindingKey<USimpleUService>().GetIndex(),
+			             DI::MakeBindingKey<FSimpleNativeService>().GetIndex());
+		});
+	});
+	Describe("GetTypeSlot", [this]
+	{
+		It("should only flag named keys as named", [this]
+		{
+			TestFalse("MakeBindingKey<USimpleUService>().IsNamed()", DI::MakeBindingKey<USimpleUService>().IsNamed());
+			TestTrue("MakeBindingKey<USimpleUService>(\"SomeName\").IsNamed()", DI::MakeBindingKey<USimpleUService>("SomeName").IsNamed());
+		});
+		It("should hand out distinct slots per type", [this]
+		{
+			TestNotEqual("GetTypeSlot<USimpleUService>() != GetTypeSlot<FSimpleNativeService>()",
+			             DI::GetTypeSlot<USimpleUService>(), DI::GetTypeSlot<FSimpleNativeService>());
+			TestEqual("GetTypeSlot<USimpleUService>()", DI::GetTypeSlot<USimpleUService>(), DI::MakeBindingKey<USimpleUService>().GetIndex());
+		});
+	});
+	Describe("GetId", [this]
+	{
+		It("should return the interned binding id", [this]
+		{
+			const DI::FBindingId BindingId = DI::MakeBindingId<FSimpleUStructService>("SomeName");
+			TestTrue("FBindingKey(BindingId).GetId() == BindingId", DI::FBindingKey(BindingId).GetId() == BindingId);
+		});
+	});
+	Describe("ToString", [this]
+	{
+		It("should describe the key like its binding id", [this]
+		{
+			const DI::FBindingId BindingId = DI::MakeBindingId<USimpleUService>("SomeName");
+			TestEqual("FBindingKey(BindingId).ToString()", DI::FBindingKey(BindingId).ToString(), BindingId.ToString());
+		});
+	});
+}
@@ -0,0 +1,122 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/BindingKeyFilter.h"
+#include "Mocks/SimpleService.h"
+
+BEGIN_DEFINE_SPEC(BindingKeyFilterSpec, "Tentacle.BindingKeyFilter",
+                  EAutomationTestFlags::EngineFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProgramContext)
+
+	static TArray<DI::FBindingKey> MakeKeys(const TCHAR* Name, int32 NumKeys)
+	{
+		TArray<DI::FBindingKey> Keys;
+		Keys.Reserve(NumKeys);
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			Keys.Add(DI::MakeBindingKey<USimpleUService>(FName(Name, i + 1)));
+		}
+		return Keys;
+	}
+
+	static double GetFalsePositiveRate(const DI::FBindingKeyFilter& Filter, TConstArrayView<DI::FBindingKey> KeysNotAdded)
+	{
+		int32 NumFalsePositives = 0;
+		for (const DI::FBindingKey& Key : KeysNotAdded)
+		{
+			NumFalsePositives += Filter.MayContain(Key) ? 1 : 0;
+		}
+		return static_cast<double>(NumFalsePositives) / KeysNotAdded.Num();
+	}
+END_DEFINE_SPEC(BindingKeyFilterSpec)
+
+void BindingKeyFilterSpec::Define()
+{
+	It("should not contain anything by default", [this]
+	{
+		TestFalse("MayContain", DI::FBindingKeyFilter().MayContain(DI::MakeBindingKey<USimpleUService>()));
+	});
+	It("should contain all added keys", [this]
+	{
+		DI::FBindingKeyFilter Filter;
+		TArray<DI::FBindingKey> Keys;
+		for (int32 i = 0; i < 100; ++i)
+		{
+			Keys.Add(DI::MakeBindingKey<USimpleUService>(FName(TEXT("BindingKeyFilterSpec"), i)));
+			Filter.Add(Keys.Last());
+		}
+		for (const DI::FBindingKey& Key : Keys)
+		{
+			TestTrue("MayContain", Filter.MayContain(Key));
+		}
+	});
+	It("should contain the keys of merged filters", [this]
+	{
+		DI::FBindingKeyFilter Filter;
+		DI::FBindingKeyFilter OtherFilter;
+		OtherFilter.Add(DI::MakeBindingKey<FSimpleNativeService>());
+		Filter.Union(OtherFilter);
+		TestTrue("MayContain", Filter.MayContain(DI::MakeBindingKey<FSimpleNativeService>()));
+	});
+	It("should contain the keys of merged filters of other sizes", [this]
+	{
+		const TArray<DI::FBindingKey> SmallKeys = MakeKeys(TEXT("BindingKeyFilterSpecSmall"), 20);
+		const TArray<DI::FBindingKey> LargeKeys = MakeKeys(TEXT("BindingKeyFilterSpecLarge"), 2000);
+		DI::FBindingKeyFilter SmallFilter;
+		DI::FBindingKeyFilter LargeFilter;
+		LargeFilter.Reset(LargeKeys.Num());
+		for (const DI::FBindingKey& Key : SmallKeys)
+		{
+			SmallFilter.Add(Key);
+		}
+		for (const DI::FBindingKey& Key : LargeKeys)
+		{
+			LargeFilter.Add(Key);
+		}
+
+		DI::FBindingKeyFilter FoldedFilter = SmallFilter;
+		FoldedFilter.Union(LargeFilter);
+		DI::FBindingKeyFilter SpreadFilter = LargeFilter;
+		SpreadFilter.Union(SmallFilter);
+		for (const TArray<DI::FBindingKey>* Keys : {&SmallKeys, &LargeKeys})
+		{
+			for (const DI::FBindingKey& Key : *Keys)
+			{
+				TestTrue("FoldedFilter.MayContain", FoldedFilter.MayContain(Key));
+				TestTrue("SpreadFilter.MayContain", SpreadFilter.MayContain(Key));
+			}
+		}
+		TestEqual("SpreadFilter.Num()", SpreadFilter.Num(), SmallKeys.Num() + LargeKeys.Num());
+	});
+	It("should report when it holds more keys than it has been sized for", [this]
+	{
+		DI::FBindingKeyFilter Filter;
+		Filter.Reset(10);
+		const TArray<DI::FBindingKey> Keys = MakeKeys(TEXT("BindingKeyFilterSpecOverload"), Filter.GetNumBits());
+		int32 NumKeysBeforeOverload = 0;
+		for (const DI::FBindingKey& Key : Keys)
+		{
+			Filter.Add(Key);
+			if (Filter.IsOverloaded())
+				break;
+			++NumKeysBeforeOverload;
+		}
+		TestTrue("IsOverloaded", Filter.IsOverloaded());
+		TestTrue("NumKeysBeforeOverload >= 10", NumKeysBeforeOverload >= 10);
+	});
+	It("should keep the false positive rate below one percent when sized for its keys", [this]
+	{
+		const TArray<DI::FBindingKey> KeysNotAdded = MakeKeys(TEXT("BindingKeyFilterSpecNotAdded"), 20000);
+		for (const int32 NumKeys : {30, 300, 3000})
+		{
+			DI::FBindingKeyFilter Filter;
+			Filter.Reset(NumKeys);
+			for (const DI::FBindingKey& Key : MakeKeys(TEXT("BindingKeyFilterSpecAdded"), NumKeys))
+			{
+				Filter.Add(Key);
+			}
+			const double FalsePositiveRate = GetFalsePositiveRate(Filter, KeysNotAdded);
+			AddInfo(FString::Printf(TEXT("%d keys in %d bits: %.3f%% false positives"), NumKeys, Filter.GetNumBits(), FalsePositiveRate * 100));
+			TestTrue(FString::Printf(TEXT("False positive rate with %d keys"), NumKeys), FalsePositiveRate < 0.01);
+		}
+	});
+}
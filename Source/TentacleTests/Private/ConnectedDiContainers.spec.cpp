@@ -62,7 +62,255 @@ void ConnectedDiContainerSpec::Define()
 
 			TestEqual("ChildContainer.Resolve().TryGet<USimpleUService>()", ChildContainer->Resolve().TryGet<USimpleUService>(), Service);
 		});
+		It("should borrow the same binding that it would share", [this]
+		{
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+
+			const DI::FBindingKey BindingKey = DI::MakeBindingKey<USimpleUService>();
+			TestEqual("ChildContainer->FindBorrowedBinding()", ChildContainer->FindBorrowedBinding(BindingKey), ChildContainer->FindBinding(BindingKey).Get());
+		});
+		It("should not borrow from parents that have been destroyed", [this]
+		{
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			ParentContainer.Reset();
+
+			TestNull("ChildContainer->FindBorrowedBinding()", ChildContainer->FindBorrowedBinding(DI::MakeBindingKey<USimpleUService>()));
+		});
+		It("should not serve cached ancestor bindings after a higher priority parent binds", [this]
+		{
+			USimpleUService* OtherService = NewObject<USimpleUService>();
+			OtherParentContainer->Bind().Instance<USimpleUService>(OtherService);
+			TestEqual("Resolve before the bind", ChildContainer->Resolve().TryGet<USimpleUService>(), TObjectPtr<USimpleUService>(OtherService));
+
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			TestEqual("Resolve after the bind", ChildContainer->Resolve().TryGet<USimpleUService>(), Service);
+		});
+		It("should not serve cached ancestor bindings after reparenting", [this]
+		{
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			TestEqual("Resolve before reparenting", ChildContainer->Resolve().TryGet<USimpleUService>(), Service);
+
+			TSharedRef<DI::FChainedDiContainer> NewParentContainer = MakeShared<DI::FChainedDiContainer>();
+			USimpleUService* OtherService = NewObject<USimpleUService>();
+			NewParentContainer->Bind().Instance<USimpleUService>(OtherService);
+			ChildContainer->SetParentContainer(NewParentContainer);
+			TestEqual("Resolve after reparenting", ChildContainer->Resolve().TryGet<USimpleUService>(), TObjectPtr<USimpleUService>(OtherService));
+		});
+		It("should not serve cached winning parents after the parent has been removed", [this]
+		{
+			USimpleUService* OtherService = NewObject<USimpleUService>();
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			OtherParentContainer->Bind().Instance<USimpleUService>(OtherService);
+			TestEqual("Resolve before removing", ChildContainer->Resolve().TryGet<USimpleUService>(), Service);
+
+			ForkingDiContainer->RemoveParentContainer(ParentContainer);
+			TestEqual("Resolve after removing", ChildContainer->Resolve().TryGet<USimpleUService>(), TObjectPtr<USimpleUService>(OtherService));
+		});
+		It("should resolve from an ancestor shared by both parents", [this]
+		{
+			TSharedRef<DI::FChainedDiContainer> SharedContainer = MakeShared<DI::FChainedDiContainer>();
+			ParentContainer->SetParentContainer(SharedContainer);
+			OtherParentContainer->SetParentContainer(SharedContainer);
 
+			TestFalse("Resolve before the bind", bool(ChildContainer->Resolve().TryGet<USimpleUService>(DI::EResolveErrorBehavior::ReturnNull)));
+
+			SharedContainer->Bind().Instance<USimpleUService>(Service);
+			TestEqual("Resolve after the bind", ChildContainer->Resolve().TryGet<USimpleUService>(), Service);
+		});
+	});
+	Describe("GetBindingFilter", [this]
+	{
+		It("should grow with the keys bound in the ancestors", [this]
+		{
+			const TSharedRef<FSimpleNativeService> NativeService = MakeShared<FSimpleNativeService>(20);
+			for (int32 i = 0; i < 1000; ++i)
+			{
+				ParentContainer->Bind().NamedInstance<FSimpleNativeService>(NativeService, FName(TEXT("ConnectedDiContainerSpecBound"), i + 1));
+			}
+
+			const DI::FBindingKeyFilter& BindingFilter = static_cast<const DI::FConnectedDiContainer&>(*ChildContainer).GetBindingFilter();
+			int32 NumFalsePositives = 0;
+			for (int32 i = 0; i < 10000; ++i)
+			{
+				NumFalsePositives += BindingFilter.MayContain(DI::MakeBindingKey<FSimpleNativeService>(FName(TEXT("ConnectedDiContainerSpecNotBound"), i + 1))) ? 1 : 0;
+			}
+			TestTrue("BindingFilter.MayContain(bound key)", BindingFilter.MayContain(DI::MakeBindingKey<FSimpleNativeService>(FName(TEXT("ConnectedDiContainerSpecBound"), 1000))));
+			TestTrue("False positive rate below one percent", NumFalsePositives < 100);
+		});
+	});
+	Describe("FindBorrowedBindings", [this]
+	{
+		It("should resolve many bindings from different ancestors at once", [this]
+		{
+			TSharedRef<DI::FChainedDiContainer> SharedContainer = MakeShared<DI::FChainedDiContainer>();
+			OtherParentContainer->SetParentContainer(SharedContainer);
+			TSharedRef<FSimpleNativeService> NativeService = MakeShared<FSimpleNativeService>(20);
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			SharedContainer->Bind().Instance<FSimpleNativeService>(NativeService);
+
+			auto [ResolvedUService, ResolvedNativeService, ResolvedNamedUService] = ChildContainer->Resolve().TryGetManyNamed<USimpleUService, FSimpleNativeService, USimpleUService>(
+				DI::EResolveErrorBehavior::ReturnNull, NAME_None, NAME_None, "NotBound");
+			TestEqual("ResolvedUService", ResolvedUService, Service);
+			TestEqual("ResolvedNativeService", ResolvedNativeService, TSharedPtr<FSimpleNativeService>(NativeService));
+			TestNull("ResolvedNamedUService", ResolvedNamedUService.Get());
+		});
+	});
+	Describe("Ref", [this]
+	{
+		It("should keep a factory binding alive while its factory releases the container", [this]
+		{
+			TSharedPtr<DI::FChainedDiContainer> FactoryContainer = MakeShared<DI::FChainedDiContainer>();
+			FactoryContainer->Bind().Factory<USimpleUService>([&FactoryContainer, Service = Service]
+			{
+				FactoryContainer.Reset();
+				return Service;
+			});
+			DI::TDiRef<USimpleUService> ServiceRef = FactoryContainer->Resolve().Ref<USimpleUService>();
+
+			TestEqual("ServiceRef.Get()", ServiceRef.Get(), Service);
+			TestFalse("FactoryContainer.IsValid()", FactoryContainer.IsValid());
+			TestFalse("ServiceRef.IsBound() after the container is gone", ServiceRef.IsBound());
+		});
+		It("should resolve bindings that are bound after the ref has been created", [this]
+		{
+			DI::TDiRef<USimpleUService> ServiceRef = ChildContainer->Resolve().Ref<USimpleUService>();
+			TestFalse("ServiceRef.IsBound() before the bind", ServiceRef.IsBound());
+
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			TestEqual("ServiceRef.Get() after the bind", ServiceRef.Get(), Service);
+		});
+		It("should follow higher priority bindings", [this]
+		{
+			USimpleUService* OtherService = NewObject<USimpleUService>();
+			OtherParentContainer->Bind().Instance<USimpleUService>(OtherService);
+			DI::TDiRef<USimpleUService> ServiceRef = ChildContainer->Resolve().Ref<USimpleUService>();
+			TestEqual("ServiceRef.Get() before the bind", ServiceRef.Get(), TObjectPtr<USimpleUService>(OtherService));
+
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			TestEqual("ServiceRef.Get() after the bind", ServiceRef.Get(), Service);
+		});
+		It("should not resolve after the parent has been removed", [this]
+		{
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			DI::TDiRef<USimpleUService> ServiceRef = ChildContainer->Resolve().Ref<USimpleUService>();
+			TestEqual("ServiceRef.Get() before removing", ServiceRef.Get(), Service);
+
+			ForkingDiContainer->RemoveParentContainer(ParentContainer);
+			TestFalse("ServiceRef.IsBound() after removing", ServiceRef.IsBound());
+		});
+		It("should not resolve after its container has been destroyed", [this]
+		{
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			DI::TDiRef<USimpleUService> ServiceRef = ChildContainer->Resolve().Ref<USimpleUService>();
+			ChildContainer.Reset();
+
+			TestFalse("ServiceRef.IsBound()", ServiceRef.IsBound());
+		});
+		It("should only be invalidated by the containers it resolves through", [this]
+		{
+			TSharedRef<DI::FChainedDiContainer> UnrelatedContainer = MakeShared<DI::FChainedDiContainer>();
+			TSharedRef<DI::FChainedDiContainer> UnrelatedChildContainer = MakeShared<DI::FChainedDiContainer>();
+			const uint64 InitialGeneration = ChildContainer->GetResolveGeneration();
+
+			UnrelatedChildContainer->SetParentContainer(UnrelatedContainer);
+			UnrelatedContainer->Bind().Instance<USimpleUService>(Service);
+			TestEqual("GetResolveGeneration() after unrelated changes", ChildContainer->GetResolveGeneration(), InitialGeneration);
+
+			ParentContainer->Bind().Instance<USimpleUService>(Service);
+			TestNotEqual("GetResolveGeneration() after binding into an ancestor", ChildContainer->GetResolveGeneration(), InitialGeneration);
+		});
+	});
+	Describe("All", [this]
+	{
+		It("should merge the instances of all ancestors", [this]
+		{
+			USimpleUService* ParentService = NewObject<USimpleUService>();
+			USimpleUService* OtherParentService = NewObject<USimpleUService>();
+			ChildContainer->Bind().MultiInstance<USimpleUService>(Service);
+			OtherParentContainer->Bind().MultiInstance<USimpleUService>(OtherParentService);
+			ParentContainer->Bind().MultiInstance<USimpleUService>(ParentService);
+
+			const TConstArrayView<TObjectPtr<USimpleUService>> Services = ChildContainer->Resolve().All<USimpleUService>();
+			if (TestEqual("Services.Num()", Services.Num(), 3))
+			{
+				TestEqual("Services[0]", Services[0], Service);
+				TestEqual("Services[1]", Services[1], TObjectPtr<USimpleUService>(ParentService));
+				TestEqual("Services[2]", Services[2], TObjectPtr<USimpleUService>(OtherParentService));
+			}
+		});
+		It("should merge the instances of an ancestor shared by both parents once", [this]
+		{
+			TSharedRef<DI::FChainedDiContainer> SharedContainer = MakeShared<DI::FChainedDiContainer>();
+			ParentContainer->SetParentContainer(SharedContainer);
+			OtherParentContainer->SetParentContainer(SharedContainer);
+			SharedContainer->Bind().MultiInstance<USimpleUService>(Service);
+			ParentContainer->Bind().MultiInstance<USimpleUService>(NewObject<USimpleUService>());
+
+			TestEqual("ChildContainer->Resolve().All<USimpleUService>().Num()", ChildContainer->Resolve().All<USimpleUService>().Num(), 2);
+		});
+		It("should reuse the merged instances until anything is bound", [this]
+		{
+			ChildContainer->Bind().MultiInstance<USimpleUService>(Service);
+			ParentContainer->Bind().MultiInstance<USimpleUService>(NewObject<USimpleUService>());
+			const TConstArrayView<TObjectPtr<USimpleUService>> First = ChildContainer->Resolve().All<USimpleUService>();
+			const TConstArrayView<TObjectPtr<USimpleUService>> Second = ChildContainer->Resolve().All<USimpleUService>();
+			TestTrue("Second.GetData() == First.GetData()", Second.GetData() == First.GetData());
+
+			ParentContainer->Bind().MultiInstance<USimpleUService>(NewObject<USimpleUService>());
+			TestEqual("Num after the bind", ChildContainer->Resolve().All<USimpleUService>().Num(), 3);
+		});
+	});
+	Describe("AsyncFactory", [this]
+	{
+		LatentIt("should bind the instance once the factory finished", FTimespan::FromSeconds(1), [this](FDoneDelegate Done)
+		{
+			ChildContainer->Resolve().WaitFor<FSimpleNativeService>().Next([Done, this](TOptional<TSharedRef<FSimpleNativeService>> ResolvedService)
+			{
+				if (TestTrue("ResolvedService.IsSet()", ResolvedService.IsSet()))
+				{
+					// The factory marks instances that it created on the game thread with 0.
+					TestEqual("ResolvedService->A", (*ResolvedService)->A, 20);
+				}
+				Done.Execute();
+			});
+			ParentContainer->Bind().AsyncFactory<FSimpleNativeService>([]
+			{
+				return MakeShared<FSimpleNativeService>(IsInGameThread() ? 0 : 20);
+			});
+		});
+		It("should not start the factory when the binding is taken", [this]
+		{
+			ParentContainer->Bind().Instance<FSimpleNativeService>(MakeShared<FSimpleNativeService>(20));
+			bool bFactoryStarted = false;
+			TOptional<DI::EBindResult> Result;
+			ParentContainer->Bind().AsyncFactory<FSimpleNativeService>([&bFactoryStarted]
+			{
+				bFactoryStarted = true;
+				return MakeShared<FSimpleNativeService>(22);
+			}, DI::EBindConflictBehavior::None).Next([&Result](TOptional<DI::EBindResult> BindResult)
+			{
+				Result = BindResult;
+			});
+			TestTrue("Result == Conflict", Result.IsSet() && *Result == DI::EBindResult::Conflict);
+			TestFalse("bFactoryStarted", bFactoryStarted);
+		});
+		LatentIt("should shadow the binding of an ancestor", FTimespan::FromSeconds(1), [this](FDoneDelegate Done)
+		{
+			ParentContainer->Bind().Instance<FSimpleNativeService>(MakeShared<FSimpleNativeService>(20));
+			ChildContainer->Bind().AsyncFactory<FSimpleNativeService>([]
+			{
+				return MakeShared<FSimpleNativeService>(22);
+			}).Next([Done, this](TOptional<DI::EBindResult> BindResult)
+			{
+				TestTrue("BindResult == Bound", BindResult.IsSet() && *BindResult == DI::EBindResult::Bound);
+				TSharedPtr<FSimpleNativeService> ResolvedService = ChildContainer->Resolve().TryGet<FSimpleNativeService>();
+				if (TestTrue("ResolvedService.IsValid()", ResolvedService.IsValid()))
+				{
+					TestEqual("ResolvedService->A", ResolvedService->A, 22);
+				}
+				Done.Execute();
+			});
+		});
 	});
 	Describe("BindSpecific", [this]
 	{
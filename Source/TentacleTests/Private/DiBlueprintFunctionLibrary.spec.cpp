@@ -0,0 +1,68 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Contexts/DiBlueprintFunctionLibrary.h"
+#include "Contexts/DiContainerObject.h"
+#include "Mocks/SimpleService.h"
+
+BEGIN_DEFINE_SPEC(DiBlueprintFunctionLibrarySpec, "Tentacle.DiBlueprintFunctionLibrary",
+                  EAutomationTestFlags::EngineFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProgramContext)
+
+	TObjectPtr<UDiContainerObject> DiContainerObject;
+
+	/** TryResolveInterface has a custom thunk, so it has to be called like Blueprints do. */
+	UObject* CallTryResolveInterface(UClass* InterfaceType)
+	{
+		UFunction* Function = UDiBlueprintFunctionLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UDiBlueprintFunctionLibrary, TryResolveInterface));
+		uint8* Params = static_cast<uint8*>(FMemory_Alloca_Aligned(Function->ParmsSize, Function->GetMinAlignment()));
+		Function->InitializeStruct(Params);
+		CastFieldChecked<FInterfaceProperty>(Function->FindPropertyByName(TEXT("DiContextInterface")))
+			->SetPropertyValue_InContainer(Params, TScriptInterface<IDiContextInterface>(DiContainerObject.Get()));
+		CastFieldChecked<FClassProperty>(Function->FindPropertyByName(TEXT("InterfaceType")))
+			->SetObjectPropertyValue_InContainer(Params, InterfaceType);
+
+		UDiBlueprintFunctionLibrary::StaticClass()->GetDefaultObject()->ProcessEvent(Function, Params);
+
+		UObject* Result = CastFieldChecked<FInterfaceProperty>(Function->GetReturnProperty())->GetPropertyValue_InContainer(Params).GetObject();
+		Function->DestroyStruct(Params);
+		return Result;
+	}
+END_DEFINE_SPEC(DiBlueprintFunctionLibrarySpec)
+
+void DiBlueprintFunctionLibrarySpec::Define()
+{
+	BeforeEach([this]
+	{
+		DiContainerObject = NewObject<UDiContainerObject>();
+	});
+	AfterEach([this]
+	{
+		DiContainerObject = nullptr;
+	});
+	Describe("TryResolveObject", [this]
+	{
+		It("should run the factory of a factory binding", [this]
+		{
+			USimpleUService* Service = NewObject<USimpleUService>();
+			DiContainerObject->GetDiContainer().Bind().Factory<USimpleUService>([Service] { return TObjectPtr<USimpleUService>(Service); });
+
+			UObject* Resolved = UDiBlueprintFunctionLibrary::TryResolveObject(DiContainerObject.Get(), USimpleUService::StaticClass(), NAME_None);
+			TestTrue("Resolved == Service", Resolved == Service);
+		});
+	});
+	Describe("TryResolveInterface", [this]
+	{
+		It("should run the factory of a factory binding", [this]
+		{
+			USimpleInterfaceImplementation* Implementation = NewObject<USimpleInterfaceImplementation>();
+			DiContainerObject->GetDiContainer().Bind().Factory<ISimpleInterface>([Implementation]
+			{
+				return TScriptInterface<ISimpleInterface>(Implementation);
+			});
+
+			UObject* Resolved = CallTryResolveInterface(USimpleInterface::StaticClass());
+			TestTrue("Resolved == Implementation", Resolved == Implementation);
+		});
+	});
+}
@@ -58,6 +58,184 @@ void DiContainerSpec::Define()
 				TestEqual("Resolved->A", Resolved->A, 20);
 			}
 		});
+		It("should bind ustructs that do not fit inline", [this]
+		{
+			FLargeUStructService Service;
+			Service.Name = TEXT("Large");
+			Service.Values[31] = 20;
+			DiContainer.Bind().Instance<FLargeUStructService>(Service);
+			TOptional<const FLargeUStructService&> Resolved = DiContainer.Resolve().TryGet<FLargeUStructService>();
+			if (TestTrue("Resolved.IsSet()", Resolved.IsSet()))
+			{
+				TestEqual("Resolved->Name", Resolved->Name, Service.Name);
+				TestEqual("Resolved->Values[31]", Resolved->Values[31], 20);
+			}
+		});
+	});
+	Describe("Factory", [this]
+	{
+		It("should only create the instance when it is resolved", [this]
+		{
+			int32 NumCreated = 0;
+			DiContainer.Bind().Factory<FSimpleNativeService>([&NumCreated]
+			{
+				++NumCreated;
+				return MakeShared<FSimpleNativeService>(20);
+			});
+			TestEqual("NumCreated after binding", NumCreated, 0);
+
+			const TSharedPtr<FSimpleNativeService> Resolved = DiContainer.Resolve().TryGet<FSimpleNativeService>();
+			const TSharedPtr<FSimpleNativeService> ResolvedAgain = DiContainer.Resolve().TryGet<FSimpleNativeService>();
+			TestEqual("NumCreated after resolving", NumCreated, 1);
+			TestEqual("ResolvedAgain", ResolvedAgain, Resolved);
+			TestEqual("Resolved->A", Resolved->A, 20);
+		});
+		It("should create UObjects", [this]
+		{
+			const TObjectPtr<USimpleUService> Service = NewObject<USimpleUService>();
+			DiContainer.Bind().NamedFactory<USimpleUService>([Service] { return Service; }, "Lazy");
+			TestEqual("DiContainer.Resolve().TryGetNamed<USimpleUService>()", DiContainer.Resolve().TryGetNamed<USimpleUService>("Lazy"), Service);
+		});
+		It("should conflict with instances of the same binding", [this]
+		{
+			DiContainer.Bind().Instance<FSimpleNativeService>(MakeShared<FSimpleNativeService>(20));
+			const DI::EBindResult Result = DiContainer.Bind().Factory<FSimpleNativeService>([] { return MakeShared<FSimpleNativeService>(22); },
+				DI::EBindConflictBehavior::None);
+			TestEqual("Result", Result, DI::EBindResult::Conflict);
+		});
+		LatentIt("should serve subscribers that wait for the binding", [this](const FDoneDelegate& DoneDelegate)
+		{
+			const TObjectPtr<USimpleUService> Service = NewObject<USimpleUService>();
+			DiContainer.Resolve().WaitFor<USimpleUService>().Next([DoneDelegate, this, Service](TOptional<TObjectPtr<USimpleUService>> Instance)
+			{
+				if (TestTrue("Instance.IsSet()", Instance.IsSet()))
+				{
+					TestEqual("Instance", Instance->Get(), Service.Get());
+				}
+				DoneDelegate.Execute();
+			});
+			DiContainer.Bind().Factory<USimpleUService>([Service] { return Service; });
+		});
+	});
+	Describe("Transient", [this]
+	{
+		It("should resolve a new native instance every time", [this]
+		{
+			DiContainer.Bind().Transient<FSimpleNativeService>();
+			const TSharedPtr<FSimpleNativeService> First = DiContainer.Resolve().TryGet<FSimpleNativeService>();
+			const TSharedPtr<FSimpleNativeService> Second = DiContainer.Resolve().TryGet<FSimpleNativeService>();
+			TestNotNull("First", First.Get());
+			TestNotNull("Second", Second.Get());
+			TestNotEqual("Second", Second, First);
+		});
+		It("should reuse released native instances", [this]
+		{
+			TSharedRef<DI::TInstancePool<FSimpleNativeService>> Pool = MakeShared<DI::TInstancePool<FSimpleNativeService>>(
+				[](FSimpleNativeService& Instance) { Instance.A = 0; });
+			DiContainer.Bind().Transient<FSimpleNativeService>(Pool);
+
+			TSharedPtr<FSimpleNativeService> First = DiContainer.Resolve().TryGet<FSimpleNativeService>();
+			FSimpleNativeService* FirstInstance = First.Get();
+			First->A = 20;
+			First.Reset();
+			TestEqual("Pool->NumFree()", Pool->NumFree(), 1);
+
+			const TSharedPtr<FSimpleNativeService> Second = DiContainer.Resolve().TryGet<FSimpleNativeService>();
+			TestEqual("Second", Second.Get(), FirstInstance);
+			TestEqual("Second->A", Second->A, 0);
+		});
+		It("should reuse released UObject instances", [this]
+		{
+			TSharedRef<DI::TInstancePool<USimpleUService>> Pool = MakeShared<DI::TInstancePool<USimpleUService>>();
+			DiContainer.Bind().Transient<USimpleUService>(Pool);
+
+			const TObjectPtr<USimpleUService> First = DiContainer.Resolve().TryGet<USimpleUService>();
+			TestNotEqual("Second", DiContainer.Resolve().TryGet<USimpleUService>(), First);
+
+			Pool->Release(First);
+			TestEqual("Third", DiContainer.Resolve().TryGet<USimpleUService>(), First);
+		});
+	});
+	Describe("SoftObject", [this]
+	{
+		It("should resolve soft objects that are loaded", [this]
+		{
+			const TObjectPtr<USimpleUService> Service = NewObject<USimpleUService>();
+			DiContainer.Bind().SoftObject<USimpleUService>(TSoftObjectPtr<USimpleUService>(Service.Get()));
+			TestEqual("DiContainer.Resolve().TryGet<USimpleUService>()", DiContainer.Resolve().TryGet<USimpleUService>(), Service);
+		});
+		It("should not load soft objects when resolving synchronously", [this]
+		{
+			const FSoftObjectPath MissingPath(TEXT("/Game/Tentacle/DoesNotExist.DoesNotExist"));
+			DiContainer.Bind().SoftObject<USimpleUService>(TSoftObjectPtr<USimpleUService>(MissingPath));
+			TestNull("DiContainer.Resolve().TryGet<USimpleUService>()", DiContainer.Resolve().TryGet<USimpleUService>(DI::EResolveErrorBehavior::ReturnNull).Get());
+			TestTrue("DiContainer.Bind().Instance<USimpleUService>() conflicts", DiContainer.Bind().Instance<USimpleUService>(NewObject<USimpleUService>(), DI::EBindConflictBehavior::None) == DI::EBindResult::Conflict);
+		});
+	});
+	Describe("MultiInstance", [this]
+	{
+		It("should resolve all instances in the order they have been bound", [this]
+		{
+			const TSharedRef<FSimpleNativeService> First = MakeShared<FSimpleNativeService>(1);
+			const TSharedRef<FSimpleNativeService> Second = MakeShared<FSimpleNativeService>(2);
+			DiContainer.Bind().MultiInstance<FSimpleNativeService>(First);
+			DiContainer.Bind().MultiInstance<FSimpleNativeService>(Second);
+
+			const TConstArrayView<TSharedRef<FSimpleNativeService>> Instances = DiContainer.Resolve().All<FSimpleNativeService>();
+			if (TestEqual("Instances.Num()", Instances.Num(), 2))
+			{
+				TestTrue("Instances[0] == First", Instances[0] == First);
+				TestTrue("Instances[1] == Second", Instances[1] == Second);
+			}
+		});
+		It("should not conflict with the single binding", [this]
+		{
+			const TObjectPtr<USimpleUService> Service = NewObject<USimpleUService>();
+			DiContainer.Bind().Instance<USimpleUService>(Service);
+			TestTrue("DiContainer.Bind().MultiInstance<USimpleUService>() binds",
+			         DiContainer.Bind().MultiInstance<USimpleUService>(NewObject<USimpleUService>()) == DI::EBindResult::Bound);
+
+			TestEqual("DiContainer.Resolve().TryGet<USimpleUService>()", DiContainer.Resolve().TryGet<USimpleUService>(), Service);
+			TestEqual("DiContainer.Resolve().All<USimpleUService>().Num()", DiContainer.Resolve().All<USimpleUService>().Num(), 1);
+			TestEqual("DiContainer.Resolve().AllNamed<USimpleUService>(\"Other\").Num()", DiContainer.Resolve().AllNamed<USimpleUService>(FName("Other")).Num(), 0);
+		});
+	});
+	Describe("TryGetStructView", [this]
+	{
+		It("should view the bound struct without copying it", [this]
+		{
+			FLargeUStructService Service;
+			Service.Values[31] = 20;
+			DiContainer.Bind().Instance<FLargeUStructService>(Service);
+
+			const DI::FStructBindingView View = DiContainer.Resolve().TryGetStructView<FLargeUStructService>();
+			TOptional<const FLargeUStructService&> Resolved = DiContainer.Resolve().TryGet<FLargeUStructService>();
+			if (TestTrue("View.IsValid()", View.IsValid()) && TestTrue("Resolved.IsSet()", Resolved.IsSet()))
+			{
+				TestEqual("View.GetScriptStruct()", View.GetScriptStruct(), FLargeUStructService::StaticStruct());
+				TestEqual("View.GetPtr()", View.GetPtr<FLargeUStructService>(), &Resolved.GetValue());
+				TestNull("View.GetPtr<FSimpleUStructService>()", View.GetPtr<FSimpleUStructService>());
+			}
+		});
+		It("should keep the struct alive after the container is gone", [this]
+		{
+			FLargeUStructService Service;
+			Service.Values[31] = 20;
+			DiContainer.Bind().Instance<FLargeUStructService>(Service);
+
+			const DI::FStructBindingView View = DiContainer.Resolve().TryGetUStructView(FLargeUStructService::StaticStruct(), NAME_None);
+			DiContainer = DI::FDiContainer();
+			if (const FLargeUStructService* Viewed = View.GetPtr<FLargeUStructService>(); TestNotNull("View.GetPtr()", Viewed))
+			{
+				TestEqual("Viewed->Values[31]", Viewed->Values[31], 20);
+			}
+		});
+		It("should return an empty view for missing bindings", [this]
+		{
+			const DI::FStructBindingView View = DiContainer.Resolve().TryGetStructView<FSimpleUStructService>(DI::EResolveErrorBehavior::ReturnNull);
+			TestFalse("View.IsValid()", View.IsValid());
+			TestNull("View.GetMemory()", View.GetMemory());
+		});
 	});
 
 	Describe("Resolve", [this]
@@ -152,6 +330,13 @@ void DiContainerSpec::Define()
 					TestEqual("Resolved->A", Resolved->A, 22);
 				}
 			});
+			It("should resolve with compile time binding names", [this]
+			{
+				using FSomeName = DI::TBindingName<"SomeName">;
+				TestEqual("DiContainer.Resolve().TryGetNamed<USimpleUService>(FSomeName())", DiContainer.Resolve().TryGetNamed<USimpleUService>(FSomeName())->A, 22);
+				TestTrue("FSomeName::GetKey<USimpleUService>()", FSomeName::GetKey<USimpleUService>() == DI::MakeBindingKey<USimpleUService>("SomeName"));
+				TestTrue("TBindingKey::GetKey()", DI::TBindingKey<USimpleUService, "SomeName">::GetKey() == DI::MakeBindingKey<USimpleUService>("SomeName"));
+			});
 
 			It("should not resolve named UObjects with wrong name", [this]
 			{
@@ -260,6 +445,28 @@ void DiContainerSpec::Define()
 				DiContainer.Bind().Instance<FSimpleNativeService>(NativeServiceSharedPtr);
 			});
 
+			LatentIt("should resolve multiple UObjects when some are provided later", FTimespan::FromSeconds(1), [this](const FDoneDelegate& DoneDelegate)
+			{
+				TObjectPtr<USimpleUService> UService = NewObject<USimpleUService>();
+				TSharedRef<FSimpleNativeService> NativeServiceSharedPtr = MakeShared<FSimpleNativeService>();
+				DiContainer.Bind().Instance<USimpleUService>(UService);
+				DiContainer
+					.Resolve()
+					.WaitForMany<USimpleUService, FSimpleNativeService>()
+					.AndThenExpand([DoneDelegate, this, UService, NativeServiceSharedPtr](TObjectPtr<USimpleUService> ObjectService, TSharedRef<FSimpleNativeService> NativeService)
+						{
+							TestEqual("ObjectService", ObjectService, UService);
+							TestEqual("NativeService", NativeService, NativeServiceSharedPtr);
+							DoneDelegate.Execute();
+						}
+					).OrElse([this, DoneDelegate]()
+					{
+						AddError("WaitForMany was canceled");
+						DoneDelegate.Execute();
+					});
+				DiContainer.Bind().Instance<FSimpleNativeService>(NativeServiceSharedPtr);
+			});
+
 			It("should invoke with unset optional when di container goes out of scope", [this]()
 			{
 				auto TempDiContainer = DI::FDiContainer();
@@ -282,6 +489,61 @@ void DiContainerSpec::Define()
 		});
 	});
 
+	Describe("Seal", [this]
+	{
+		It("should resolve bindings that were bound before sealing", [this]
+		{
+			const TObjectPtr<USimpleUService> Service = NewObject<USimpleUService>();
+			DiContainer.Bind().Instance<USimpleUService>(Service);
+			DiContainer.Bind().NamedInstance<FSimpleNativeService>(MakeShared<FSimpleNativeService>(20), "SomeName");
+			DiContainer.Seal();
+
+			TestTrue("DiContainer.IsSealed()", DiContainer.IsSealed());
+			TestEqual("DiContainer.Resolve().TryGet<USimpleUService>()", DiContainer.Resolve().TryGet<USimpleUService>(), Service);
+			TestEqual("DiContainer.Resolve().TryGetNamed<FSimpleNativeService>(\"SomeName\")->A",
+			          DiContainer.Resolve().TryGetNamed<FSimpleNativeService>("SomeName")->A, 20);
+			TestNull("DiContainer.Resolve().TryGet<FSimpleNativeService>()",
+			         DiContainer.Resolve().TryGet<FSimpleNativeService>(DI::EResolveErrorBehavior::ReturnNull).Get());
+		});
+		It("should reject bindings after sealing", [this]
+		{
+			DiContainer.Seal();
+			const DI::EBindResult Result = DiContainer.Bind().Instance<USimpleUService>(NewObject<USimpleUService>(), DI::EBindConflictBehavior::None);
+			TestTrue("Result == DI::EBindResult::Rejected", Result == DI::EBindResult::Rejected);
+			TestNull("DiContainer.Resolve().TryGet<USimpleUService>()",
+			         DiContainer.Resolve().TryGet<USimpleUService>(DI::EResolveErrorBehavior::ReturnNull).Get());
+		});
+		It("should not keep the instances of rejected bindings alive", [this]
+		{
+			DiContainer.Seal();
+			const TSharedRef<FSimpleNativeService> Service = MakeShared<FSimpleNativeService>(20);
+			DiContainer.Bind().Instance<FSimpleNativeService>(Service, DI::EBindConflictBehavior::None);
+			TestEqual("Service.GetSharedReferenceCount()", Service.GetSharedReferenceCount(), 1);
+		});
+	});
+	Describe("EnableTypeSlots", [this]
+	{
+		It("should resolve unnamed and named bindings", [this]
+		{
+			DiContainer.EnableTypeSlots();
+			const TObjectPtr<USimpleUService> Service = NewObject<USimpleUService>();
+			const TObjectPtr<USimpleUService> NamedService = NewObject<USimpleUService>();
+			DiContainer.Bind().Instance<USimpleUService>(Service);
+			DiContainer.Bind().NamedInstance<USimpleUService>(NamedService, "SomeName");
+
+			TestEqual("DiContainer.Resolve().TryGet<USimpleUService>()", DiContainer.Resolve().TryGet<USimpleUService>(), Service);
+			TestEqual("DiContainer.Resolve().TryGetNamed<USimpleUService>(\"SomeName\")", DiContainer.Resolve().TryGetNamed<USimpleUService>("SomeName"), NamedService);
+		});
+		It("should keep bindings that were bound before enabling", [this]
+		{
+			const TObjectPtr<USimpleUService> Service = NewObject<USimpleUService>();
+			DiContainer.Bind().Instance<USimpleUService>(Service);
+			DiContainer.EnableTypeSlots();
+			DiContainer.Seal();
+
+			TestEqual("DiContainer.Resolve().TryGet<USimpleUService>()", DiContainer.Resolve().TryGet<USimpleUService>(), Service);
+		});
+	});
 	Describe("Inject", [this]
 	{
 		Describe("Sync", [this]
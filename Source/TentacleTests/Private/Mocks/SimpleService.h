@@ -37,6 +37,18 @@ struct FSimpleUStructService
 	}
 };
 
+/** Too large to be stored inline in a struct binding. */
+USTRUCT()
+struct FLargeUStructService
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	int32 Values[32] = {};
+};
+
 class FSimpleNativeService
 {
 public:
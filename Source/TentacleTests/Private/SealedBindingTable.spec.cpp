@@ -0,0 +1,50 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/SealedBindingTable.h"
+#include "Mocks/SimpleService.h"
+
+BEGIN_DEFINE_SPEC(SealedBindingTableSpec, "Tentacle.SealedBindingTable",
+                  EAutomationTestFlags::EngineFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProgramContext)
+
+	TArray<TSharedPtr<DI::FBinding>> Bindings;
+END_DEFINE_SPEC(SealedBindingTableSpec)
+
+void SealedBindingTableSpec::Define()
+{
+	BeforeEach([this]
+	{
+		Bindings.Reset();
+		const TSharedRef<FSimpleNativeService> Service = MakeShared<FSimpleNativeService>(20);
+		// Keys of other types are interned in between, so the keys of the table are spread over the key indices like in a real container.
+		for (int32 i = 0; i < 400; ++i)
+		{
+			DI::MakeBindingKey<USimpleUService>(FName(TEXT("SealedBindingTableSpecGap"), i + 1));
+			Bindings.Add(MakeShared<DI::TSharedNativeDependencyBinding<FSimpleNativeService>>(
+				DI::MakeBindingId<FSimpleNativeService>(FName(TEXT("SealedBindingTableSpec"), i + 1)), Service));
+		}
+	});
+	AfterEach([this]
+	{
+		Bindings.Reset();
+	});
+	It("should find every binding it has been built with", [this]
+	{
+		const DI::FSealedBindingTable Table(Bindings);
+		for (const TSharedPtr<DI::FBinding>& Binding : Bindings)
+		{
+			const TSharedPtr<DI::FBinding>* FoundBinding = Table.Find(Binding->GetKey());
+			if (TestNotNull("Table.Find()", FoundBinding))
+			{
+				TestTrue("*Table.Find() == Binding", *FoundBinding == Binding);
+			}
+		}
+		TestNull("Table.Find() of a key that is not in the table",
+		         Table.Find(DI::MakeBindingKey<USimpleUService>(FName(TEXT("SealedBindingTableSpecGap"), 1))));
+	});
+	It("should stay close to one slot per binding", [this]
+	{
+		const DI::FSealedBindingTable Table(Bindings);
+		TestTrue("Table.GetNumSlots() <= 1.5 * Bindings.Num()", Table.GetNumSlots() <= Bindings.Num() * 3 / 2);
+	});
+}
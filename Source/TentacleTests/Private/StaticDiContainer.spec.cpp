@@ -0,0 +1,135 @@
+﻿// Copyright singinwhale https://www.singinwhale.com and contributors. Distributed under the MIT license.
+
+
+#include "Container/ChainedDiContainer.h"
+#include "Container/StaticDiContainer.h"
+#include "Mocks/SimpleService.h"
+
+namespace DI
+{
+	static_assert(DiContainerConcept<TStaticDiContainer<USimpleUService>>);
+	static_assert(DiContainerConcept<TChainedStaticDiContainer<USimpleUService>>);
+	static_assert(CClosedDiContainer<TStaticDiContainer<USimpleUService>>);
+	static_assert(!CClosedDiContainer<TChainedStaticDiContainer<USimpleUService>>);
+	static_assert(CStaticBindingProvider<TStaticDiContainer<USimpleUService>, USimpleUService>);
+	static_assert(!CStaticBindingProvider<TStaticDiContainer<USimpleUService>, FSimpleNativeService>);
+}
+
+using FTestStaticDiContainer = DI::TStaticDiContainer<USimpleUService, ISimpleInterface, FSimpleUStructService, FSimpleNativeService>;
+using FTestChainedStaticDiContainer = DI::TChainedStaticDiContainer<FSimpleNativeService>;
+
+BEGIN_DEFINE_SPEC(StaticDiContainerSpec, "Tentacle.StaticDiContainer",
+                  EAutomationTestFlags::EngineFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProgramContext)
+
+	TUniquePtr<FTestStaticDiContainer> DiContainer;
+END_DEFINE_SPEC(StaticDiContainerSpec)
+
+void StaticDiContainerSpec::Define()
+{
+	BeforeEach([this]
+	{
+		DiContainer = MakeUnique<FTestStaticDiContainer>();
+	});
+	AfterEach([this]
+	{
+		DiContainer.Reset();
+	});
+	Describe("Bind", [this]
+	{
+		It("should bind all declared kinds of types", [this]
+		{
+			TObjectPtr<USimpleUService> UService = NewObject<USimpleUService>();
+			TObjectPtr<USimpleInterfaceImplementation> UInterfaceService = NewObject<USimpleInterfaceImplementation>();
+			FSimpleUStructService UStructService = {20};
+			TSharedRef<FSimpleNativeService> NativeService = MakeShared<FSimpleNativeService>(20);
+			DiContainer->Bind().Instance<USimpleUService>(UService);
+			DiContainer->Bind().Instance<ISimpleInterface>(UInterfaceService);
+			DiContainer->Bind().Instance<FSimpleUStructService>(UStructService);
+			DiContainer->Bind().Instance<FSimpleNativeService>(NativeService);
+
+			auto [ResolvedUService, ResolvedUInterface, ResolvedUStruct, ResolvedNativeService] = DiContainer->Resolve().TryGetMany<USimpleUService, ISimpleInterface, FSimpleUStructService, FSimpleNativeService>();
+			TestEqual("ObjectService", ResolvedUService.Get(), UService.Get());
+			TestEqual<UObject*>("InterfaceService", ResolvedUInterface.GetObject(), UInterfaceService.Get());
+			if (TestTrue("StructService.IsSet()", ResolvedUStruct.IsSet()))
+			{
+				TestEqual("StructService", *ResolvedUStruct, UStructService);
+			}
+			TestEqual("NativeService", ResolvedNativeService, NativeService.ToSharedPtr());
+		});
+		It("should report conflicts", [this]
+		{
+			DiContainer->Bind().Instance<USimpleUService>(NewObject<USimpleUService>());
+			const DI::EBindResult Result = DiContainer->Bind().Instance<USimpleUService>(NewObject<USimpleUService>(), DI::EBindConflictBehavior::None);
+			TestEqual("Result", Result, DI::EBindResult::Conflict);
+		});
+		It("should reject named bindings", [this]
+		{
+			const DI::EBindResult Result = DiContainer->Bind().NamedInstance<USimpleUService>(NewObject<USimpleUService>(), "SomeName", DI::EBindConflictBehavior::None);
+			TestEqual("Result", Result, DI::EBindResult::Rejected);
+		});
+	});
+	Describe("Resolve", [this]
+	{
+		It("should return null for unbound types", [this]
+		{
+			TestNull("DiContainer->Resolve().TryGet<USimpleUService>()", DiContainer->Resolve().TryGet<USimpleUService>(DI::EResolveErrorBehavior::ReturnNull).Get());
+		});
+		It("should find bindings by key", [this]
+		{
+			DiContainer->Bind().Instance<FSimpleNativeService>(MakeShared<FSimpleNativeService>());
+			TestNotNull("FindBinding(MakeBindingKey<FSimpleNativeService>())", DiContainer->FindBinding(DI::MakeBindingKey<FSimpleNativeService>()).Get());
+			TestNull("FindBinding(MakeBindingKey<USimpleUService>())", DiContainer->FindBinding(DI::MakeBindingKey<USimpleUService>()).Get());
+		});
+		LatentIt("WaitFor should resolve UObjects when provided later", [this](const FDoneDelegate& DoneDelegate)
+		{
+			TObjectPtr<USimpleUService> UService = NewObject<USimpleUService>();
+			DiContainer->Resolve().WaitFor<USimpleUService>().Next([DoneDelegate, this, UService](TOptional<TObjectPtr<USimpleUService>> Instance)
+			{
+				TestEqual("Resolved instance", Instance->Get(), UService.Get());
+				DoneDelegate.Execute();
+			});
+			DiContainer->Bind().Instance<USimpleUService>(UService);
+		});
+	});
+	Describe("Inject", [this]
+	{
+		It("should inject into lambda functions", [this]
+		{
+			TSharedRef<FSimpleNativeService> NativeService = MakeShared<FSimpleNativeService>();
+			DiContainer->Bind().Instance<FSimpleNativeService>(NativeService);
+			TSharedPtr<FSimpleNativeService> Injected;
+			DiContainer->Inject().IntoLambda([&](TSharedRef<FSimpleNativeService> InNativeService)
+			{
+				Injected = InNativeService;
+			});
+			TestEqual("Injected", Injected, NativeService.ToSharedPtr());
+		});
+	});
+	Describe("Chained", [this]
+	{
+		It("should resolve undeclared types from the parent", [this]
+		{
+			TSharedRef<DI::FChainedDiContainer> ParentContainer = MakeShared<DI::FChainedDiContainer>();
+			FTestChainedStaticDiContainer ChildContainer(ParentContainer);
+			TObjectPtr<USimpleUService> UService = NewObject<USimpleUService>();
+			TSharedRef<FSimpleNativeService> NativeService = MakeShared<FSimpleNativeService>();
+			ParentContainer->Bind().Instance<USimpleUService>(UService);
+			ChildContainer.Bind().Instance<FSimpleNativeService>(NativeService);
+
+			TestEqual("USimpleUService", ChildContainer.Resolve().TryGet<USimpleUService>().Get(), UService.Get());
+			TestEqual("FSimpleNativeService", ChildContainer.Resolve().TryGet<FSimpleNativeService>(), NativeService.ToSharedPtr());
+		});
+		LatentIt("WaitFor should resolve undeclared types once bound in the parent", [this](const FDoneDelegate& DoneDelegate)
+		{
+			TSharedRef<DI::FChainedDiContainer> ParentContainer = MakeShared<DI::FChainedDiContainer>();
+			FTestChainedStaticDiContainer ChildContainer(ParentContainer);
+			TObjectPtr<USimpleUService> UService = NewObject<USimpleUService>();
+			ChildContainer.Resolve().WaitFor<USimpleUService>().Next([DoneDelegate, this, UService](TOptional<TObjectPtr<USimpleUService>> Instance)
+			{
+				TestEqual("Resolved instance", Instance->Get(), UService.Get());
+				DoneDelegate.Execute();
+			});
+			ParentContainer->Bind().Instance<USimpleUService>(UService);
+		});
+	});
+}
@@ -2,6 +2,7 @@
 
 
 #include "TentacleTemplates.h"
+#include "Container/Binding.h"
 #include "CoreMinimal.h"
 #include "Mocks/SimpleService.h"
 
@@ -18,6 +19,11 @@ namespace DI
 		static_assert(TModels<CNativeMemberTypeIdProvider, FSimpleNativeService>::Value, "Native classes should provide native type ids through members");
 		static_assert(!TModels<CNativeMemberTypeIdProvider, FMockEngineType>::Value, "Native foreign classes should provide native type ids through free functions");
 		static_assert(sizeof(DI::GetFreeTypeId<FMockEngineType>()), "Native foreign classes should provide native type ids through free functions");
+		static_assert(DI::GetTypeId<FSimpleNativeService>() == DI::GetTypeId<FSimpleNativeService>(), "Native member type ids should be compile time constants");
+		static_assert(std::is_trivially_copyable_v<FTypeId>, "Type ids should be trivially copyable");
+		static_assert(sizeof(FTypeId) == sizeof(void*), "Type ids should be a single tagged pointer");
+		static_assert(!std::is_polymorphic_v<FBinding>, "Bindings should dispatch on their kind instead of a vtable");
+		static_assert(!std::is_polymorphic_v<TBindingType<USimpleUService>>, "Bindings should dispatch on their kind instead of a vtable");
 
 		static_assert(!THasUClass<FSimpleUStructService>::Value, "UStruct should not have a UClass");
 		static_assert(THasUStruct<FSimpleUStructService>::Value, "UStruct should have a UStruct");